@@ -6,6 +6,7 @@ add_compile_options(-std=c++17 -fPIC)
 option(USE_DLR_RT                    "Enable DLR inference" ON)
 option(USE_TENSORFLOW_RT             "Enable Tensorflow inference" ON)
 option(USE_ONNX_RT                   "Enable Onnx inference" ON)
+option(USE_DL_INFER_TRACE            "Enable the trace spans" ON)
 
 # Specific compile optios across all targets
 #add_compile_definitions(MINIMAL_LOGGING)
@@ -55,6 +56,10 @@ if(USE_ONNX_RT)
 add_definitions(-DUSE_ONNX_RT)
 endif()
 
+if(USE_DL_INFER_TRACE)
+add_definitions(-DUSE_DL_INFER_TRACE)
+endif()
+
 link_directories(${TARGET_FS}/usr/lib/aarch64-linux-gnu
                  ${TARGET_FS}/usr/lib/
                  )
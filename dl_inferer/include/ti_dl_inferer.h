@@ -66,11 +66,21 @@
 #include <string>
 #include <cstdarg>
 #include <vector>
+#include <memory>
+#include <deque>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <functional>
+#include <condition_variable>
 #include <stdexcept>
+#include <sched.h>
 
 /* Module headers. */
 #include <ti_dl_inferer_config.h>
+#include <ti_dl_inferer_stats.h>
+#include <ti_dl_inferer_trace.h>
 
 /**
  * \defgroup group_dl_inferer Deep Learning Inference engine
@@ -102,6 +112,13 @@
  */
 #define DL_INFER_RTTYPE_ONNX                "onnxrt"
 
+/**
+ * \brief Constant for the synthetic inferer, which does not need any runtime
+ *        and mimics the interface of a model
+ * \ingroup group_dl_inferer
+ */
+#define DL_INFER_RTTYPE_NULL                "null"
+
 namespace ti::dl_inferer
 {
     /**
@@ -145,9 +162,63 @@ namespace ti::dl_inferer
      } DlInferType;
 
 
+    /**
+     * \brief Enumeration for the layout of the image data.
+     *
+     * \ingroup group_dl_inferer
+     */
+    typedef enum
+    {
+        /** Unknown or not an image. */
+        DlTensorLayout_Unknown = 0,
+
+        /** Planar, channels first. */
+        DlTensorLayout_NCHW    = 1,
+
+        /** Interleaved, channels last. */
+        DlTensorLayout_NHWC    = 2,
+
+     } DlTensorLayout;
+
+    /**
+     * \brief Enumeration for the concurrency a runtime supports on a single
+     *        inferer instance.
+     *
+     * \ingroup group_dl_inferer
+     */
+    typedef enum
+    {
+        /** The run() calls are serialized on the instance. */
+        DlConcurrency_Serialized = 0,
+
+        /** The run() calls may overlap, each with its own buffers. */
+        DlConcurrency_Concurrent = 1,
+
+     } DlConcurrency;
+
     /** Helper function to get size of Dltensor data types in bytes. */
     uint8_t getTypeSize(DlInferType type);
 
+    /**
+     * \brief Affine quantization parameters of a tensor. The real value of a
+     *        stored element q is (q - zeroPoint) * scale. A single entry
+     *        applies to the whole tensor, otherwise there is one entry per
+     *        index along 'axis'.
+     *
+     * \ingroup group_dl_inferer
+     */
+    struct DlQuantParams
+    {
+        /** Scales. Empty if the tensor is not quantized. */
+        std::vector<float>      scale;
+
+        /** Zero points, one per scale. */
+        std::vector<int32_t>    zeroPoint;
+
+        /** Dimension the per-channel parameters apply to. */
+        int32_t                 axis{0};
+    };
+
     /* Forward declaration. */
     class DLInferer;
 
@@ -160,6 +231,11 @@ namespace ti::dl_inferer
      *        For TVM generated models, the 'name' field could be NULL for the
      *        output paramaters.
      *
+     *        A tensor owns the buffer it allocates. The ownership moves with
+     *        the object and can be shared with other tensors through share().
+     *        Memory owned by the application is attached through wrap(),
+     *        which tells when the tensors are done with it.
+     *
      * \ingroup group_dl_inferer
      */
     class DlTensor
@@ -194,6 +270,19 @@ namespace ti::dl_inferer
             /** Shape information. */
             std::vector<int64_t>    shape;
 
+            /** Distance, in number of elements, between two consecutive
+             *  entries of each dimension. An empty vector means the data is
+             *  packed. This allows describing a region of interest or a
+             *  buffer with a row pitch without copying it.
+             */
+            std::vector<int64_t>    strides;
+
+            /** Layout of the image data. */
+            DlTensorLayout          layout{DlTensorLayout_Unknown};
+
+            /** Quantization parameters, if the model provides them. */
+            DlQuantParams           quant;
+
             /** Data buffer. */
             void                   *data{nullptr};
 
@@ -203,9 +292,30 @@ namespace ti::dl_inferer
             DlTensor();
 
             /**
-             * Copy constructor.
+             * Copy constructor. Copying is not allowed since it is ambiguous
+             * whether the copy should own a buffer. Please use cloneInfo()
+             * or share() instead.
+             */
+            DlTensor(const DlTensor& rhs) = delete;
+
+            /**
+             * Move constructor. The buffer and its ownership are transferred
+             * and 'rhs' is left without a buffer.
              */
-            DlTensor(const DlTensor& rhs);
+            DlTensor(DlTensor&& rhs) noexcept;
+
+            /**
+             * Returns a tensor with the same information as this one but
+             * without any buffer.
+             */
+            DlTensor cloneInfo() const;
+
+            /**
+             * Returns a tensor pointing to the same buffer as this one. The
+             * ownership of the buffer is shared and it is returned to the
+             * pool when the last owner goes away.
+             */
+            DlTensor share() const;
 
             /**
              * Dumps the information to the screen.
@@ -213,15 +323,87 @@ namespace ti::dl_inferer
             void dumpInfo() const;
 
             /**
-             * Allocate memory for the buffer.
+             * Returns true if the data is packed, irrespective of the
+             * strides being set or not.
+             */
+            bool isContiguous() const;
+
+            /**
+             * Returns true if the elements are stored quantized.
+             */
+            bool isQuantized() const;
+
+            /**
+             * Copies the data to 'dst' in packed form. The innermost
+             * dimensions that are contiguous get copied in one block.
+             *
+             * @param dst Destination of at least 'size' bytes
+             */
+            void packTo(void *dst) const;
+
+            /**
+             * Allocate memory for the buffer. Any buffer previously
+             * allocated by this object is returned to the pool, unless it
+             * is still shared with other tensors.
              */
             void allocateDataBuffer(DLInferer& inferer);
 
             /**
-             * Assignment operator.
+             * Points the tensor to memory owned by the application, such as
+             * a camera or DMA buffer, without copying it. The memory is
+             * tracked like an allocated buffer: share() shares it and
+             * 'deleter' is invoked once the last tensor holding it lets go
+             * of it, be it destroyed, wrapped again, or given a larger
+             * buffer by reshape(). Any buffer previously held is released.
+             *
+             * @param ptr Start of the memory
+             * @param bytes Size in bytes of the memory. If the shape is
+             *              known, it must hold 'size' bytes, or span the
+             *              elements up to the last one given 'strides'.
+             * @param deleter Invoked with 'ptr' when the memory is no longer
+             *                used. Nothing is invoked if empty, in which
+             *                case the memory must outlive the tensors.
+             *
+             * @returns 0 upon success, after which the tensor is responsible
+             *          for invoking 'deleter'. A nagative value otherwise,
+             *          in which case the tensor is left unchanged.
+             */
+            int32_t wrap(void                          *ptr,
+                         int64_t                        bytes,
+                         std::function<void(void *)>    deleter = nullptr);
+
+            /**
+             * Changes the shape and makes the buffer fit it. The strides are
+             * cleared. A new buffer is only allocated if the current one is
+             * too small, hence alternating between a few shapes stops
+             * allocating once the largest one has been seen. Memory set
+             * through wrap() holds the size given there, while memory set
+             * directly through 'data' is assumed to hold 'size' bytes.
+             * Nothing is allocated if a dimension is unknown (negative).
              *
+             * @param newShape New shape
+             * @param inferer Inferer to allocate the buffer from
              */
-            DlTensor &operator=(const DlTensor& rhs);
+            void reshape(const std::vector<int64_t> &newShape,
+                         DLInferer                  &inferer);
+
+            /**
+             * Returns the buffer owned by this object, if any. This holds the
+             * memory set through wrap() as well. It is empty if 'data' was
+             * pointed to memory owned by the application directly.
+             */
+            const std::shared_ptr<void> &getBuffer() const;
+
+            /**
+             * Assignment operator. Please refer to the copy constructor.
+             */
+            DlTensor &operator=(const DlTensor& rhs) = delete;
+
+            /**
+             * Move assignment operator. Any buffer owned by this object is
+             * released before taking over the one from 'rhs'.
+             */
+            DlTensor &operator=(DlTensor&& rhs) noexcept;
 
             /**
              * Destructor
@@ -230,8 +412,74 @@ namespace ti::dl_inferer
 
         private:
 
-            /** Flag to track if memory has been allocated. */
-            bool        dataAllocated{false};
+            /** Buffer allocated from the pool or set through wrap(), if any.
+             *  This is tracked separately from 'data' since the application
+             *  is allowed to point 'data' to its own memory.
+             */
+            std::shared_ptr<void>   buffer;
+
+            /** Size in bytes of 'buffer'. */
+            int64_t                 capacity{};
+    };
+
+    /**
+     * \brief A non-owning view of the data of a tensor or a range of items
+     *        along its leading dimension. The view does not keep the buffer
+     *        alive and must not outlive the tensor it was made from.
+     *
+     * \ingroup group_dl_inferer
+     */
+    class DlTensorView
+    {
+        public:
+            /** Name of the element. */
+            const char             *name{nullptr};
+
+            /** Unified type across APIs. */
+            DlInferType             type{DlInferType_Invalid};
+
+            /** Total size in bytes of the data in view. */
+            int64_t                 size{};
+
+            /** Total number of elements in view. */
+            int64_t                 numElem{};
+
+            /** Element size in bytes. */
+            int32_t                 elemSize{};
+
+            /** Dimensions. */
+            int32_t                 dim{};
+
+            /** Shape information. */
+            std::vector<int64_t>    shape;
+
+            /** Strides in number of elements. Empty if packed. */
+            std::vector<int64_t>    strides;
+
+            /** Data buffer. */
+            void                   *data{nullptr};
+
+            /**
+             * Default constructor.
+             */
+            DlTensorView() = default;
+
+            /**
+             * Constructs a view of the whole tensor.
+             */
+            DlTensorView(const DlTensor &tensor);
+
+            /**
+             * Returns a view of the items [begin, end) along the leading
+             * dimension. Throws std::out_of_range for an invalid range.
+             */
+            DlTensorView slice(int64_t begin, int64_t end) const;
+
+            /**
+             * Returns a view of a single item along the leading dimension.
+             * The leading dimension of the view is 1.
+             */
+            DlTensorView item(int64_t index) const;
     };
 
     /**
@@ -246,6 +494,63 @@ namespace ti::dl_inferer
      */
     using VecDlTensorPtr = std::vector<DlTensor *>;
 
+    /**
+     * \brief Completion callback for the asynchronous inference requests.
+     *        The callback is invoked from the worker thread of the inferer
+     *        after the run completes and before the associated future is
+     *        made ready. An exception thrown by the callback is logged and
+     *        does not affect the status of the request.
+     *
+     * \ingroup group_dl_inferer
+     */
+    using InferCallback = std::function<void(int32_t                status,
+                                             const VecDlTensorPtr  &inputs,
+                                             VecDlTensorPtr        &outputs)>;
+
+    /**
+     * \brief A set of input and output buffers for one inference request.
+     *        The inferer can hold a ring of these so that the application can
+     *        fill the inputs of the next frame while the current one is still
+     *        being processed.
+     *
+     * \ingroup group_dl_inferer
+     */
+    struct DlBufferSet
+    {
+        /** Input buffers. */
+        VecDlTensorPtr  inputs;
+
+        /** Output buffers. */
+        VecDlTensorPtr  outputs;
+    };
+
+    /**
+     * \brief Restricts the calling thread to a set of cores for the lifetime
+     *        of the object. Threads spawned meanwhile inherit the restriction.
+     *
+     * \ingroup group_dl_inferer
+     */
+    class DlCpuAffinityScope
+    {
+        public:
+            /**
+             * Constructor. Nothing is done if 'cores' is empty.
+             *
+             * @param cores Cores to run on
+             */
+            DlCpuAffinityScope(const std::vector<int32_t> &cores);
+
+            /** Destructor. Restores the affinity of the thread. */
+            ~DlCpuAffinityScope();
+
+        private:
+            /** Affinity of the thread before the object was created. */
+            cpu_set_t   m_saved;
+
+            /** The affinity was changed and has to be restored. */
+            bool        m_restore{false};
+    };
+
     /** \brief An abstract base class for different class of RT inference API.
      *
      * \ingroup group_dl_inferer
@@ -254,7 +559,11 @@ namespace ti::dl_inferer
     {
         public:
             /**
-             * Runs the model.
+             * Runs the model. For a model with dynamic input dimensions,
+             * reported as -1 by getInputInfo(), the shape of each input is
+             * taken from the tensor passed, see DlTensor::reshape(). The
+             * shape of the outputs is then updated and their buffers grown
+             * as needed.
              *
              * @param inputs Input buffers to set for inference run
              * @param outputs Output buffers to set for inference run
@@ -264,6 +573,45 @@ namespace ti::dl_inferer
             virtual int32_t run(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs) = 0;
 
+            /**
+             * Registers a set of buffers to be used by run() without
+             * arguments. The runtime bindings are set up once here and only
+             * redone by a later run when the data pointer of a tensor has
+             * changed. The tensors must stay alive until other buffers are
+             * registered or the inferer is destroyed. This must not be
+             * called concurrently with run().
+             *
+             * @param inputs Input buffers
+             * @param outputs Output buffers
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t registerBuffers(const VecDlTensorPtr &inputs,
+                                    VecDlTensorPtr       &outputs);
+
+            /**
+             * Runs the model on the buffers set by registerBuffers().
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t run();
+
+            /**
+             * Runs the model on a batch of frames. Entry 'i' of 'inputs' and
+             * 'outputs' holds the buffers of frame 'i', laid out as expected
+             * by run(). The runtimes supporting a dynamic leading dimension
+             * pack the frames into a single batched tensor and scatter the
+             * outputs back per frame. Otherwise run() is called once per
+             * frame.
+             *
+             * @param inputs Input buffers of each frame
+             * @param outputs Output buffers of each frame
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            virtual int32_t runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                                     std::vector<VecDlTensorPtr>       &outputs);
+
             /**
              * Dumps the model information to the screen.
              */
@@ -287,13 +635,60 @@ namespace ti::dl_inferer
 
             /**
              * Returns an allocated pointer that can be consumed by inference
-             * of the model by this framework.
+             * of the model by this framework. The memory comes from the
+             * allocator set through setAllocator(), cached by the process
+             * wide DlBufferPool, and must be returned to the pool through
+             * DlBufferPool::release().
              *
              * @returns An pointer to allocated memory.
              */
-            virtual void *allocate(int64_t size)
+            void *allocate(int64_t size);
+
+            /**
+             * Sets the allocator of the buffers allocated from now on. The
+             * buffers allocated earlier are not affected. makeInferer() sets
+             * the one from InfererConfig::allocator.
+             *
+             * @param allocator Allocator. The default heap allocator is used
+             *                  if null.
+             */
+            void setAllocator(const std::shared_ptr<DlAllocator> &allocator);
+
+            /**
+             * Returns the allocator of the buffers. A nullptr means the
+             * default heap allocator.
+             */
+            const std::shared_ptr<DlAllocator> &getAllocator() const;
+
+            /**
+             * Sets the cores the model runs on. The thread calling run() is
+             * restricted to them for the duration of the call, and so are
+             * the runtime worker threads created by the runs. This must be
+             * set before running. makeInferer() sets the one from
+             * InfererConfig::cpuTuning.
+             *
+             * @param cores Cores to run on. No restriction if empty.
+             */
+            void setCpuAffinity(const std::vector<int32_t> &cores);
+
+            /**
+             * Returns the alignment in bytes the underlying runtime expects
+             * for the data buffers.
+             */
+            virtual int32_t getBufferAlignment()
             {
-                return new uint8_t [size];
+                return 64;
+            }
+
+            /**
+             * Returns whether run() may be called concurrently from several
+             * threads on this instance. A serialized inferer handles one call
+             * at a time and the parallel callers should go through an
+             * InfererPool instead.
+             */
+            virtual DlConcurrency getConcurrency()
+            {
+                return DlConcurrency_Serialized;
             }
 
             /** Factory method for making a specifc inferer based on the
@@ -305,26 +700,280 @@ namespace ti::dl_inferer
              */
             static DLInferer* makeInferer(const InfererConfig &config);
 
+            /**
+             * Parses the configuration of several models and creates their
+             * inferers concurrently on a bounded number of threads. The load
+             * time of each model is logged. Loading stops as soon as one
+             * model fails, in which case none of the inferers are returned.
+             *
+             * @param modelDirs Paths to the model directories
+             * @param enableTidl Offload to TIDL
+             * @param inferers Receives the inferers, in the order of
+             *                 'modelDirs'
+             * @param maxThreads Maximum number of threads. The number of
+             *                   hardware threads is used if 0.
+             * @param loadTimes If not null, receives the load time of each
+             *                  model in milli-seconds
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            static int32_t loadModels(const std::vector<std::string>   &modelDirs,
+                                      bool                              enableTidl,
+                                      std::vector<DLInferer *>         &inferers,
+                                      int32_t                           maxThreads = 0,
+                                      std::vector<float>               *loadTimes = nullptr);
+
             /**
              * Creates the descriptor based on the information from the
              * inference model interface information.
              *
              * @param ifInfoList Vector of inference model interface parameters
              * @param vecVar     Vector of descriptors created by this function
-             * @param allocate   Allocate memory if True
+             * @param allocate   Allocate memory if True. Otherwise the
+             *                   application provides the memory, preferably
+             *                   through DlTensor::wrap().
+             *
+             * @returns 0 upon success. A nagative value if a buffer could
+             *          not be allocated.
              */
             int32_t createBuffers(const VecDlTensor    *ifInfoList,
                                   VecDlTensorPtr        &vecVar,
                                   bool                  allocate);
 
+            /**
+             * Queues an inference request on the worker thread of this
+             * inferer and returns immediately. The requests are processed in
+             * the order they are submitted. The input and output vectors,
+             * and the buffers they point to, must stay valid until the
+             * request completes.
+             *
+             * @param inputs Input buffers to set for inference run
+             * @param outputs Output buffers to set for inference run
+             * @param callback Optional callback invoked on completion
+             *
+             * @returns A future holding the status of the run() call.
+             */
+            std::future<int32_t> runAsync(const VecDlTensorPtr &inputs,
+                                          VecDlTensorPtr       &outputs,
+                                          InferCallback         callback = nullptr);
+
+            /**
+             * Blocks until all the queued asynchronous requests complete.
+             */
+            void waitAsync();
+
+            /**
+             * Creates a ring of 'depth' input/output buffer sets using
+             * createBuffers(). Any existing ring is released. This fails
+             * while buffer sets of the existing ring are in use, and leaves
+             * no ring behind if the buffers cannot be created.
+             *
+             * @param depth Number of buffer sets in the ring
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t createBufferRing(int32_t depth);
+
+            /**
+             * Returns the next free buffer set from the ring, blocking until
+             * one is released if all of them are in use.
+             *
+             * @returns A buffer set. A nullptr if the ring has not been
+             *          created.
+             */
+            DlBufferSet *acquireBufferSet();
+
+            /**
+             * Returns a buffer set obtained through acquireBufferSet() back
+             * to the ring.
+             *
+             * @param set Buffer set to release
+             *
+             * @returns 0 upon success. A nagative value if 'set' is not an
+             *          acquired set of this ring.
+             */
+            int32_t releaseBufferSet(DlBufferSet *set);
+
+            /**
+             * Runs dummy inferences on internally allocated buffers until
+             * the run time stabilizes, to get the lazy allocations and the
+             * runtime initialization out of the way of the first frames.
+             * The inferer reports not ready while this is in progress, and
+             * the warm-up runs are left out of getStats().
+             *
+             * @param maxRuns Maximum number of runs
+             * @param pattern Contents of the inputs, "zero" or "random"
+             * @param tolerance Maximum relative difference between two
+             *                  consecutive runs for the run time to be
+             *                  considered stable
+             * @param latencies If not null, receives the run time of each
+             *                  run in milli-seconds
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t warmup(int32_t              maxRuns,
+                           const std::string   &pattern = "zero",
+                           float                tolerance = 0.1f,
+                           std::vector<float>  *latencies = nullptr);
+
+            /**
+             * Returns false while a warm-up is in progress or if the last
+             * warm-up failed.
+             */
+            bool isReady() const;
+
+            /**
+             * Returns the latency statistics of the run() calls, measured
+             * on a monotonic clock from the entry to the exit of the call.
+             *
+             * @param reset Clear the statistics after reading them
+             */
+            DlLatencyStats getStats(bool reset = false);
+
             /**
              * Destructor.
              */
-            virtual ~DLInferer(){}
+            virtual ~DLInferer();
+
+        protected:
+            /**
+             * Drains the queued asynchronous requests and stops the worker
+             * thread. The worker invokes the virtual run() and hence the
+             * concrete classes must call this at the beginning of their
+             * destructors.
+             */
+            void stopAsync();
+
+            /**
+             * Returns a pointer to the data of 'tensor' in packed form. The
+             * data of a strided tensor is packed into 'staging', whose
+             * buffer only grows.
+             */
+            void *getPackedData(const DlTensor *tensor, DlTensor &staging);
+
+            /**
+             * Validates the frames passed to runBatch(). Every frame must
+             * carry 'numInputs' inputs and 'numOutputs' outputs, and a given
+             * input must have the same size across the frames.
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t checkBatch(const std::vector<VecDlTensorPtr>  &inputs,
+                               const std::vector<VecDlTensorPtr>  &outputs,
+                               uint32_t                            numInputs,
+                               uint32_t                            numOutputs);
+
+            /**
+             * Packs input 'index' of the frames along the leading dimension
+             * into 'packed', whose buffer only grows. The frames must have
+             * been validated with checkBatch().
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t packBatch(const std::vector<VecDlTensorPtr> &inputs,
+                              uint32_t                           index,
+                              DlTensor                          &packed);
+
+            /**
+             * Copies output 'index' of a batched run back to the frames.
+             * The output of each frame is reshaped to 'shape' with a leading
+             * dimension of 1, which grows its buffer if needed.
+             *
+             * @param src Data of the batched output
+             * @param shape Shape of the batched output. The leading
+             *              dimension must be the number of frames.
+             * @param outputs Output buffers of the frames
+             * @param index Index of the output
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t scatterBatch(const void                    *src,
+                                 const std::vector<int64_t>    &shape,
+                                 std::vector<VecDlTensorPtr>   &outputs,
+                                 uint32_t                       index);
+
+            /**
+             * Binds the buffers to the runtime, skipping the tensors whose
+             * data pointer is the one bound last. The caller holds m_mutex.
+             * The runtimes that bind per run override this and call it from
+             * run(). The default does nothing.
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            virtual int32_t bindBuffers(const VecDlTensorPtr &inputs,
+                                        VecDlTensorPtr       &outputs);
 
         protected:
             /** Mutex for multi-thread access control. */
             std::mutex  m_mutex;
+
+            /** Ready for steady state inference. */
+            std::atomic<bool>   m_ready{true};
+
+            /** Latency of the run() calls. The concrete classes record
+             *  into it with a DlLatencyScope.
+             */
+            DlLatencyHistogram  m_runStats;
+
+            /** Cores the model runs on. The concrete classes apply it in
+             *  run() with a DlCpuAffinityScope.
+             */
+            std::vector<int32_t>    m_cpuAffinity;
+
+        private:
+            /** Allocator of the data buffers. */
+            std::shared_ptr<DlAllocator>    m_allocator;
+
+            /** A queued asynchronous request. */
+            struct AsyncRequest
+            {
+                const VecDlTensorPtr   *inputs;
+                VecDlTensorPtr         *outputs;
+                InferCallback           callback;
+                std::promise<int32_t>   promise;
+            };
+
+            /** Buffers set by registerBuffers(). */
+            DlBufferSet                 m_registered;
+
+            /** Worker thread processing the asynchronous requests. */
+            void asyncWorker();
+
+            /** Asynchronous worker thread. */
+            std::thread                 m_asyncThread;
+
+            /** Mutex protecting the asynchronous request queue. */
+            std::mutex                  m_asyncMutex;
+
+            /** Signalled when a request is queued or a stop is requested. */
+            std::condition_variable     m_asyncCv;
+
+            /** Signalled when a request completes. */
+            std::condition_variable     m_asyncDoneCv;
+
+            /** Queued requests. */
+            std::deque<AsyncRequest>    m_asyncQueue;
+
+            /** Number of requests queued or in progress. */
+            int32_t                     m_asyncPending{0};
+
+            /** Flag to stop the worker thread. */
+            bool                        m_asyncStop{false};
+
+            /** Releases the buffer ring. The caller holds m_ringMutex. */
+            void deleteBufferRing();
+
+            /** Ring of buffer sets. */
+            std::vector<DlBufferSet>    m_bufferRing;
+
+            /** Buffer sets in the ring that are not in use. */
+            std::vector<DlBufferSet *>  m_freeSets;
+
+            /** Mutex protecting the free buffer set list. */
+            std::mutex                  m_ringMutex;
+
+            /** Signalled when a buffer set is released. */
+            std::condition_variable     m_ringCv;
     };
 
 #define DL_INFER_GET_EXCL_ACCESS    std::unique_lock<std::mutex> lock(this->m_mutex)
@@ -0,0 +1,255 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_ALLOCATOR_)
+#define _TI_DL_INFERER_ALLOCATOR_
+
+/* Standard headers. */
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * \defgroup group_dl_inferer_allocator Tensor memory allocators
+ *
+ * \brief Allocators providing the memory behind the tensor data buffers.
+ *        An allocator is set through InfererConfig::allocator and the
+ *        DlBufferPool caches its buffers separately from the ones of the
+ *        other allocators.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * \brief Interface of the tensor memory allocators. The implementations
+     *        must be thread safe.
+     *
+     * \ingroup group_dl_inferer_allocator
+     */
+    class DlAllocator
+    {
+        public:
+            /**
+             * Returns a buffer of at least 'size' bytes aligned to
+             * 'alignment' bytes.
+             *
+             * @param size Size of the buffer in bytes. It is a multiple of
+             *             'alignment'.
+             * @param alignment Alignment in bytes. A power of 2.
+             *
+             * @returns A pointer to the buffer. A nullptr upon failure.
+             */
+            virtual void *allocate(int64_t size, int32_t alignment) = 0;
+
+            /**
+             * Frees a buffer obtained through allocate().
+             *
+             * @param ptr Pointer returned by allocate()
+             * @param size Size passed to allocate()
+             */
+            virtual void free(void *ptr, int64_t size) = 0;
+
+            /**
+             * Returns the alignment in bytes of all the buffers returned,
+             * irrespective of the alignment requested.
+             */
+            virtual int32_t getAlignment() const = 0;
+
+            /**
+             * Returns the number of bytes an allocation of 'size' bytes
+             * actually takes, the size rounded up to the granularity of the
+             * allocator.
+             */
+            virtual int64_t getAllocSize(int64_t size) const
+            {
+                return size;
+            }
+
+            /**
+             * Returns the name of the allocator.
+             */
+            virtual const char *getName() const = 0;
+
+            /**
+             * Creates an allocator from its name. The valid names are
+             * "default", "hugepage" and "memfd".
+             *
+             * @returns The allocator. A nullptr if the name is unknown.
+             */
+            static std::shared_ptr<DlAllocator> makeAllocator(const std::string &name);
+
+            /**
+             * Returns the process wide heap allocator used when none is
+             * configured.
+             */
+            static const std::shared_ptr<DlAllocator> &getDefault();
+
+            /**
+             * Destructor
+             */
+            virtual ~DlAllocator() = default;
+    };
+
+    /**
+     * \brief Allocator using the aligned heap allocation of the C library.
+     *
+     * \ingroup group_dl_inferer_allocator
+     */
+    class DlHeapAllocator: public DlAllocator
+    {
+        public:
+            virtual void *allocate(int64_t size, int32_t alignment) override;
+
+            virtual void free(void *ptr, int64_t size) override;
+
+            virtual int32_t getAlignment() const override;
+
+            virtual const char *getName() const override;
+    };
+
+    /**
+     * \brief Allocator backing the buffers with huge pages, which reduces
+     *        the TLB misses when walking large tensors. Explicit huge pages
+     *        (MAP_HUGETLB) are used if the system has reserved some, and
+     *        transparent huge pages (madvise(MADV_HUGEPAGE)) otherwise. The
+     *        sizes are rounded up to the huge page size, hence this is meant
+     *        for large buffers.
+     *
+     * \ingroup group_dl_inferer_allocator
+     */
+    class DlHugePageAllocator: public DlAllocator
+    {
+        public:
+            /**
+             * Constructor.
+             */
+            DlHugePageAllocator();
+
+            virtual void *allocate(int64_t size, int32_t alignment) override;
+
+            virtual void free(void *ptr, int64_t size) override;
+
+            virtual int32_t getAlignment() const override;
+
+            virtual int64_t getAllocSize(int64_t size) const override;
+
+            virtual const char *getName() const override;
+
+        private:
+            /** Size in bytes of a huge page. */
+            int64_t     m_pageSize;
+
+            /** Explicit huge pages are not available. Once a MAP_HUGETLB
+             *  mapping has failed, only transparent huge pages are tried.
+             */
+            std::atomic<bool>   m_noExplicit{false};
+
+    };
+
+    /**
+     * \brief Allocator backing every buffer with its own anonymous memory
+     *        file (memfd). The file descriptor of a buffer can be passed to
+     *        another process, for instance over a UNIX socket, which maps
+     *        the same memory without copying it.
+     *
+     * \ingroup group_dl_inferer_allocator
+     */
+    class DlMemfdAllocator: public DlAllocator
+    {
+        public:
+            virtual void *allocate(int64_t size, int32_t alignment) override;
+
+            virtual void free(void *ptr, int64_t size) override;
+
+            virtual int32_t getAlignment() const override;
+
+            virtual int64_t getAllocSize(int64_t size) const override;
+
+            virtual const char *getName() const override;
+
+            /**
+             * Returns the file descriptor of the memory file behind a
+             * buffer. The descriptor stays owned by the allocator and is
+             * closed when the buffer is freed.
+             *
+             * @param ptr Start of a buffer returned by allocate()
+             *
+             * @returns The file descriptor. A negative value if 'ptr' is not
+             *          a buffer of this allocator.
+             */
+            int32_t getFd(const void *ptr);
+
+        private:
+            /** Mutex protecting the descriptor map. */
+            std::mutex                                  m_mutex;
+
+            /** Memory file descriptor of each buffer. */
+            std::unordered_map<const void *, int32_t>   m_fds;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_ALLOCATOR_
@@ -0,0 +1,232 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_BUFFER_POOL_)
+#define _TI_DL_INFERER_BUFFER_POOL_
+
+/* Standard headers. */
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+
+/* Module headers. */
+#include <ti_dl_inferer_allocator.h>
+
+/**
+ * \defgroup group_dl_inferer_buffer_pool Tensor buffer pool
+ *
+ * \brief Process wide pool of tensor data buffers. The buffers are grouped
+ *        into size buckets so that a released buffer can be handed out again
+ *        for any request that falls into the same bucket, which avoids the
+ *        allocator churn and fragmentation caused by repeatedly creating and
+ *        destroying inference buffers in long running applications.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * \brief Usage statistics of the buffer pool.
+     *
+     * \ingroup group_dl_inferer_buffer_pool
+     */
+    struct DlBufferPoolStats
+    {
+        /** Number of requests served from the cached buffers. */
+        uint64_t    hits{};
+
+        /** Number of requests that needed a new allocation. */
+        uint64_t    misses{};
+
+        /** Number of buffers currently handed out. */
+        uint64_t    numInUse{};
+
+        /** Total size in bytes of the buffers currently handed out. */
+        int64_t     inUseBytes{};
+
+        /** Total size in bytes of the buffers held in the free lists. */
+        int64_t     cachedBytes{};
+    };
+
+    /**
+     * \brief Size bucketed pool of aligned buffers shared by all the
+     *        inferers in the process.
+     *
+     * \ingroup group_dl_inferer_buffer_pool
+     */
+    class DlBufferPool
+    {
+        public:
+            /**
+             * Returns the process wide pool instance.
+             */
+            static DlBufferPool &getInstance();
+
+            /**
+             * Returns a buffer of at least 'size' bytes aligned to
+             * 'alignment' bytes. The buffers of each allocator are cached
+             * separately and the pool keeps an allocator alive as long as
+             * it holds buffers from it.
+             *
+             * @param size Size of the buffer in bytes
+             * @param alignment Alignment in bytes. Must be a power of 2.
+             * @param allocator Allocator providing the memory. The default
+             *                  heap allocator is used if null.
+             *
+             * @returns A pointer to the buffer. A nullptr upon failure.
+             */
+            void *allocate(int64_t                              size,
+                           int32_t                              alignment,
+                           const std::shared_ptr<DlAllocator>  &allocator = nullptr);
+
+            /**
+             * Returns a buffer obtained through allocate() to the pool.
+             *
+             * @param ptr Pointer returned by allocate()
+             */
+            void release(void *ptr);
+
+            /**
+             * Frees all the cached buffers. The buffers that are in use are
+             * not affected.
+             */
+            void trim();
+
+            /**
+             * Sets the upper limit on the total size of the cached buffers.
+             * Buffers released beyond this limit are freed right away.
+             *
+             * @param maxBytes Limit in bytes
+             */
+            void setMaxCachedBytes(int64_t maxBytes);
+
+            /**
+             * Returns the usage statistics.
+             */
+            DlBufferPoolStats getStats();
+
+            /**
+             * Dumps the usage statistics to the screen.
+             */
+            void dumpInfo();
+
+        private:
+            /** Bucket key: rounded size, alignment and allocator. */
+            using Key = std::tuple<int64_t, int32_t, DlAllocator *>;
+
+            /** Constructor. Use getInstance() to access the pool. */
+            DlBufferPool() = default;
+
+            /**
+             * Rounds the size up to the bucket it belongs to. Each power of
+             * two range is split into four buckets, which bounds the memory
+             * overhead to 25% of the requested size.
+             */
+            static int64_t getBucketSize(int64_t size, int32_t alignment);
+
+            /**
+             * Frees all the cached buffers. The caller holds m_mutex.
+             */
+            void freeCached();
+
+            /**
+             * Returns a buffer to its allocator, dropping the allocator once
+             * the pool holds no buffer from it. The caller holds m_mutex.
+             */
+            void freeBuffer(void *ptr, const Key &key);
+
+            /** Mutex protecting the pool state. */
+            std::mutex                              m_mutex;
+
+            /** Free buffers per bucket. */
+            std::map<Key, std::vector<void *>>      m_freeLists;
+
+            /** Buffers handed out, with their bucket. */
+            std::unordered_map<void *, Key>         m_inUse;
+
+            /** An allocator the pool holds buffers from. */
+            struct AllocatorEntry
+            {
+                /** Reference keeping the allocator alive. */
+                std::shared_ptr<DlAllocator>    allocator;
+
+                /** Number of buffers in use or cached. */
+                uint64_t                        numBuffers{};
+            };
+
+            /** Allocators the pool holds buffers from. */
+            std::unordered_map<DlAllocator *, AllocatorEntry>   m_allocators;
+
+            /** Upper limit on the cached bytes. */
+            int64_t                                 m_maxCachedBytes{256*1024*1024};
+
+            /** Usage statistics. */
+            DlBufferPoolStats                       m_stats;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_BUFFER_POOL_
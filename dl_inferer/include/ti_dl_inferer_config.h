@@ -64,6 +64,11 @@
 
 /* Standard headers. */
 #include <string>
+#include <vector>
+#include <memory>
+
+/* Module headers. */
+#include <ti_dl_inferer_allocator.h>
 
 /**
  * \defgroup group_dl_inferer_config DL Inferer Helper Library
@@ -81,6 +86,136 @@
 
 namespace ti::dl_inferer
 {
+    /**
+     * \brief Description of an input or an output of the synthetic inferer.
+     *
+     * \ingroup group_dl_inferer_config
+     */
+    struct NullTensorSpec
+    {
+        /** Name of the tensor. */
+        std::string             name{};
+
+        /** Type of the elements. The valid values are int8, uint8, int16,
+         *  uint16, int32, uint32, int64, float16 and float32.
+         */
+        std::string             type{"float32"};
+
+        /** Shape of the tensor. */
+        std::vector<int64_t>    shape{};
+
+        /** Quantization scales, one for the whole tensor or one per index
+         *  along 'quantAxis'. Empty if the tensor is not quantized.
+         */
+        std::vector<float>      scale{};
+
+        /** Quantization zero points, one per scale. */
+        std::vector<int32_t>    zeroPoint{};
+
+        /** Dimension the per-channel quantization parameters apply to. */
+        int32_t                 quantAxis{};
+    };
+
+    /**
+     * \brief Configuration for the synthetic inferer (DL_INFER_RTTYPE_NULL).
+     *        InfererConfig::getConfig() derives it from the pre-processing,
+     *        task and post-processing sections of param.yaml, unless
+     *        param.yaml has an explicit 'null_inferer' section.
+     *
+     * \ingroup group_dl_inferer_config
+     */
+    struct NullInfererSpec
+    {
+        /** Inputs of the model. */
+        std::vector<NullTensorSpec> inputs{};
+
+        /** Outputs of the model. */
+        std::vector<NullTensorSpec> outputs{};
+
+        /** Simulated inference time in milli-seconds. */
+        float                       latencyMs{};
+
+        /** Maximum deviation in milli-seconds, uniformly distributed,
+         *  applied to the simulated inference time.
+         */
+        float                       jitterMs{};
+
+        /** Output contents. The valid values are:
+         * - zero: all zeros
+         * - random: random values across the range of the type
+         * - logits: random scores, one per class, along the last dimension
+         * - classmap: random class Id per element
+         * - detection: random boxes of [x1 y1 x2 y2 label score] per row,
+         *              ordered as per 'formatter'
+         * - echo: the bytes of the first input, repeated to fill the output
+         */
+        std::string                 fill{"zero"};
+
+        /** Number of classes for the logits, classmap and detection fills. */
+        int32_t                     numClasses{1};
+
+        /** Labels to pick from for the detection fill. Labels in the range
+         *  [0, numClasses) are used if empty.
+         */
+        std::vector<int32_t>        labels{};
+
+        /** Position of x1, y1, x2, y2, label and score in a detection. */
+        std::vector<int32_t>        formatter{0, 1, 2, 3, 4, 5};
+
+        /** Generate detection boxes normalized to [0, 1] instead of the
+         *  input resolution.
+         */
+        bool                        normDetect{false};
+
+        /** Seed for the random generator. */
+        uint32_t                    seed{};
+
+        /** Size in bytes of the synthetic weights held by the model. They
+         *  are written at creation so that they count towards the resident
+         *  memory, and are shared like the weights of a real model.
+         */
+        int64_t                     weightsBytes{};
+
+        /** Mimic a runtime whose run() may be called concurrently on one
+         *  instance. Only the output generation is serialized.
+         */
+        bool                        concurrent{false};
+    };
+
+    /**
+     * \brief CPU execution settings of an inferer. These matter mostly when
+     *        the model, or a part of it, runs on ARM.
+     *
+     * \ingroup group_dl_inferer_config
+     */
+    struct CpuTuning
+    {
+        /** Number of threads used to run an operator. The inferer default
+         *  is used if 0, which is 1 for the ONNX API and the runtime default
+         *  for the TFLITE API. Not looked at for the DLR API.
+         */
+        int32_t                 intraOpThreads{0};
+
+        /** Number of threads used to run independent operators in parallel.
+         *  The runtime default is used if 0. This field is specific to the
+         *  ONNX API when 'parallelExecution' is set, and is ignored with a
+         *  warning otherwise.
+         */
+        int32_t                 interOpThreads{0};
+
+        /** Run independent operators in parallel instead of sequentially.
+         *  This field is specific to the ONNX API.
+         */
+        bool                    parallelExecution{false};
+
+        /** Cores the model runs on. The thread calling run() is restricted
+         *  to them for the duration of the call, and the runtime worker
+         *  threads inherit the restriction when created, be it with the
+         *  inferer or on a run. No restriction is applied if empty.
+         */
+        std::vector<int32_t>    cpuAffinity{};
+    };
+
     /**
      * \brief Configuration for the DL inferer.
      *
@@ -103,6 +238,7 @@ namespace ti::dl_inferer
          * - DL_INFER_RTTYPE_DLR
          * - DL_INFER_RTTYPE_TFLITE
          * - DL_INFER_RTTYPE_ONNX
+         * - DL_INFER_RTTYPE_NULL
          */
         std::string rtType{};
 
@@ -127,6 +263,64 @@ namespace ti::dl_inferer
         /** Layout of the data. Allowed values. */
         std::string dataLayout{"NCHW"};
 
+        /** Save the graph optimized by the runtime next to the artifacts
+         *  and load it on the later starts instead of optimizing the model
+         *  again. This field is specific to the ONNX API in ARM mode and is
+         *  not looked at for the other ones.
+         */
+        bool        enableModelCache{false};
+
+        /** Share the parsed model between the instances of the same model
+         *  through the DlModelRegistry, so that the weights are held in
+         *  memory once. This field is specific to the TFLITE and ONNX APIs.
+         *  The ONNX sessions are only shared in ARM mode, where concurrent
+         *  runs on a session are safe.
+         */
+        bool        shareModel{true};
+
+        /** Number of instances of the model to create when the model is
+         *  served through an InfererPool. This field is not looked at by
+         *  DLInferer::makeInferer().
+         */
+        int32_t     numInstances{1};
+
+        /** Maximum number of dummy inference runs made by makeInferer()
+         *  before returning the inferer. The warm-up stops earlier once the
+         *  run time has stabilized. Warm-up is disabled if 0.
+         */
+        int32_t     warmupCount{0};
+
+        /** Contents of the warm-up inputs. The valid values are "zero" and
+         *  "random".
+         */
+        std::string warmupPattern{"zero"};
+
+        /** The run time is considered stable once two consecutive warm-up
+         *  runs differ by less than this fraction.
+         */
+        float       warmupTolerance{0.1f};
+
+        /** CPU threading and affinity settings. */
+        CpuTuning   cpuTuning{};
+
+        /** Maximum number of input shapes kept planned for a model with
+         *  dynamic input dimensions, so that alternating between them does
+         *  not re-allocate the runtime tensors. This field is specific to
+         *  the TFLITE API, the ONNX runtime keeps its own per-shape plans.
+         */
+        int32_t     shapeCacheSize{4};
+
+        /** Configuration of the synthetic inferer. This field is not looked
+         *  at for the other runtime APIs.
+         */
+        NullInfererSpec nullSpec{};
+
+        /** Allocator of the tensor data buffers created through the
+         *  inferer. The default heap allocator is used if null. The
+         *  allocator is shared by all the copies of the configuration.
+         */
+        std::shared_ptr<DlAllocator> allocator{};
+
         /**
          * Helper function to dump the configuration information.
          */
@@ -0,0 +1,259 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_FP16_)
+#define _TI_DL_INFERER_FP16_
+
+/* Standard headers. */
+#include <stdint.h>
+#include <cstring>
+
+/**
+ * \defgroup group_dl_inferer_fp16 Half precision helpers
+ *
+ * \brief Conversion between IEEE 754 half precision and single precision
+ *        floating point values. The bulk conversion routines use the NEON
+ *        instructions on Arm64 and the F16C instructions on x86 when the
+ *        compiler targets them, and fall back to the scalar code otherwise.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * Converts a half precision value to single precision. Sub-normal,
+     * infinite and NaN values are preserved.
+     *
+     * @param h Half precision bit pattern
+     *
+     * \ingroup group_dl_inferer_fp16
+     */
+    inline float fp16ToFp32(uint16_t h)
+    {
+        uint32_t    sign = static_cast<uint32_t>(h & 0x8000) << 16;
+        uint32_t    exp  = (h >> 10) & 0x1f;
+        uint32_t    man  = h & 0x3ff;
+        uint32_t    bits;
+        float       f;
+
+        if (exp == 0x1f)
+        {
+            bits = sign | 0x7f800000 | (man << 13);
+        }
+        else if (exp != 0)
+        {
+            bits = sign | ((exp + 112) << 23) | (man << 13);
+        }
+        else if (man == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            /* Sub-normal half, normalize the mantissa. */
+            exp = 113;
+
+            while ((man & 0x400) == 0)
+            {
+                man <<= 1;
+                exp--;
+            }
+
+            bits = sign | (exp << 23) | ((man & 0x3ff) << 13);
+        }
+
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /**
+     * Converts a single precision value to half precision, rounding to the
+     * nearest even value. Values beyond the half precision range become
+     * infinite.
+     *
+     * @param f Single precision value
+     *
+     * \ingroup group_dl_inferer_fp16
+     */
+    inline uint16_t fp32ToFp16(float f)
+    {
+        uint32_t    bits;
+        uint32_t    sign;
+        uint32_t    absBits;
+        uint32_t    r;
+        uint32_t    rem;
+
+        std::memcpy(&bits, &f, sizeof(bits));
+
+        sign    = (bits >> 16) & 0x8000;
+        absBits = bits & 0x7fffffff;
+
+        if (absBits >= 0x7f800000)
+        {
+            /* Infinity or NaN, keep NaN quiet. */
+            return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+        }
+
+        if (absBits >= 0x477ff000)
+        {
+            /* Rounds beyond 65504. */
+            return sign | 0x7c00;
+        }
+
+        if (absBits < 0x38800000)
+        {
+            /* Sub-normal half or zero. */
+            uint32_t    shift;
+            uint32_t    man;
+            uint32_t    half;
+
+            if (absBits <= 0x33000000)
+            {
+                return sign;
+            }
+
+            man   = (absBits & 0x7fffff) | 0x800000;
+            shift = 126 - (absBits >> 23);
+            half  = 1u << (shift - 1);
+            r     = man >> shift;
+            rem   = man & ((1u << shift) - 1);
+
+            if ((rem > half) || ((rem == half) && (r & 1)))
+            {
+                r++;
+            }
+
+            return sign | r;
+        }
+
+        r   = (absBits - 0x38000000) >> 13;
+        rem = absBits & 0x1fff;
+
+        if ((rem > 0x1000) || ((rem == 0x1000) && (r & 1)))
+        {
+            r++;
+        }
+
+        return sign | r;
+    }
+
+    /**
+     * Converts an array of half precision values to single precision.
+     *
+     * @param src Half precision bit patterns
+     * @param dst Output array
+     * @param numElem Number of elements to convert
+     *
+     * \ingroup group_dl_inferer_fp16
+     */
+    void convertFp16ToFp32(const uint16_t  *src,
+                           float           *dst,
+                           int64_t          numElem);
+
+    /**
+     * Converts an array of single precision values to half precision,
+     * rounding to the nearest even value.
+     *
+     * @param src Single precision values
+     * @param dst Output half precision bit patterns
+     * @param numElem Number of elements to convert
+     *
+     * \ingroup group_dl_inferer_fp16
+     */
+    void convertFp32ToFp16(const float     *src,
+                           uint16_t        *dst,
+                           int64_t          numElem);
+
+    /**
+     * \brief Storage type for the elements of a DlInferType_Float16 tensor.
+     *        It converts implicitly to and from float, so the templates
+     *        written for the other element types can be instantiated on the
+     *        tensor data directly.
+     *
+     * \ingroup group_dl_inferer_fp16
+     */
+    struct DlFloat16
+    {
+        /** Half precision bit pattern. */
+        uint16_t    bits;
+
+        /** Default constructor. */
+        DlFloat16() = default;
+
+        /** Constructor from a single precision value. */
+        DlFloat16(float f): bits(fp32ToFp16(f))
+        {
+        }
+
+        /** Single precision value. */
+        operator float() const
+        {
+            return fp16ToFp32(bits);
+        }
+    };
+
+    static_assert(sizeof(DlFloat16) == sizeof(uint16_t),
+                  "DlFloat16 must match the tensor element size.");
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_FP16_
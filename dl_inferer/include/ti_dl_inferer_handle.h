@@ -0,0 +1,224 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_HANDLE_)
+#define _TI_DL_INFERER_HANDLE_
+
+/* Standard headers. */
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+
+/**
+ * \defgroup group_dl_inferer_handle Swappable model handle
+ *
+ * \brief Holds the inferer serving a model and replaces it with a new one
+ *        loaded in the background, without stalling the callers.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /** \brief A double-buffered handle to the inferer of a model.
+     *
+     * The callers take a reference to the current inferer with acquire()
+     * once per frame and run on it. swap() builds and warms up the new
+     * inferer on a worker thread through DLInferer::makeInferer() and then
+     * publishes it atomically, so the next acquire() returns it. The
+     * previous inferer is destroyed on the worker thread once the last
+     * reference to it has been dropped, hence neither the load nor the
+     * teardown happen on the callers' path.
+     *
+     * \ingroup group_dl_inferer_handle
+     */
+    class DlModelHandle
+    {
+        public:
+            /**
+             * Constructor. Creates the initial inferer. Throws
+             * std::runtime_error on failure.
+             *
+             * @param config Configuration specifying the model
+             */
+            DlModelHandle(const InfererConfig &config);
+
+            /**
+             * Constructor. Takes ownership of an existing inferer. Throws
+             * std::runtime_error if 'inferer' is null.
+             *
+             * @param inferer Initial inferer
+             */
+            DlModelHandle(DLInferer *inferer);
+
+            /**
+             * Returns the current inferer. The reference keeps it alive
+             * across a swap and should be held for the duration of a frame.
+             * A change of the pointer returned tells that a swap happened.
+             */
+            std::shared_ptr<DLInferer> acquire() const;
+
+            /**
+             * Starts loading the model described by 'config' in the
+             * background. The current inferer keeps serving until the new
+             * one is ready.
+             *
+             * @param config Configuration specifying the new model
+             *
+             * @returns 0 if the load was started. A nagative value if a swap
+             *          is already in progress.
+             */
+            int32_t swap(const InfererConfig &config);
+
+            /**
+             * Returns true while a swap started by swap() has not completed.
+             */
+            bool isSwapPending();
+
+            /**
+             * Waits for the completion of the swap in progress, if any.
+             *
+             * @returns 0 if the last swap succeeded. A nagative value if the
+             *          new model failed to load, in which case the previous
+             *          inferer stays in place.
+             */
+            int32_t waitSwap();
+
+            /**
+             * Returns the number of swaps completed so far.
+             */
+            uint64_t getGeneration() const;
+
+            /**
+             * Checks whether two inferers have the same inputs and outputs,
+             * including their quantization parameters. The buffers and the
+             * post-processing set up for one of them can then be used with
+             * the other.
+             *
+             * @param a First inferer
+             * @param b Second inferer
+             */
+            static bool isSameSignature(DLInferer &a, DLInferer &b);
+
+            /**
+             * Destructor. Waits for the swap in progress, if any. The
+             * references returned by acquire() must have been dropped.
+             */
+            ~DlModelHandle();
+
+        private:
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            DlModelHandle & operator=(const DlModelHandle& rhs) = delete;
+
+            /** Loads the requested models and destroys the retired ones. */
+            void worker();
+
+        private:
+            /** Inferer handed out by acquire(). Accessed atomically. */
+            std::shared_ptr<DLInferer>              m_current;
+
+            /** Number of swaps completed. */
+            std::atomic<uint64_t>                   m_generation{0};
+
+            /** Replaced inferers waiting for their last user. Accessed by
+             *  the worker thread only.
+             */
+            std::vector<std::shared_ptr<DLInferer>> m_retired;
+
+            /** Configuration of the model to load next. */
+            std::unique_ptr<InfererConfig>          m_request;
+
+            /** Set while a swap is in progress. */
+            bool                                    m_pending{false};
+
+            /** Status of the last swap. */
+            int32_t                                 m_swapStatus{0};
+
+            /** Set to stop the worker thread. */
+            bool                                    m_stop{false};
+
+            /** Protects the request and the swap state. */
+            std::mutex                              m_mutex;
+
+            /** Wakes up the worker thread. */
+            std::condition_variable                 m_workerCv;
+
+            /** Signals the completion of a swap. */
+            std::condition_variable                 m_doneCv;
+
+            /** Worker thread. */
+            std::thread                             m_worker;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_HANDLE_
@@ -0,0 +1,223 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_POOL_)
+#define _TI_DL_INFERER_POOL_
+
+/* Standard headers. */
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+
+/**
+ * \defgroup group_dl_inferer_pool Pool of inferer replicas
+ *
+ * \brief Holds several instances of the same model so that multiple threads
+ *        can run inference concurrently instead of serializing on the mutex
+ *        of a single inferer. This is mainly useful when the model executes
+ *        on the ARM cores (enableTidl=false).
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /** \brief A pool of inferer instances of the same model. Idle instances
+     *         are kept in a lock-free free-list.
+     *
+     * \ingroup group_dl_inferer_pool
+     */
+    class InfererPool
+    {
+        public:
+            /**
+             * Constructor. Creates config.numInstances instances of the
+             * model described by the configuration.
+             *
+             * @param config Configuration specifying the model
+             */
+            InfererPool(const InfererConfig &config);
+
+            /**
+             * Constructor.
+             *
+             * @param config Configuration specifying the model
+             * @param numInstances Number of instances to create
+             */
+            InfererPool(const InfererConfig &config, int32_t numInstances);
+
+            /**
+             * Returns an idle instance without blocking.
+             *
+             * @returns An inferer if one is idle. A nullptr otherwise.
+             */
+            DLInferer *tryAcquire();
+
+            /**
+             * Returns an idle instance, sleeping until one is released if
+             * all of them are busy.
+             *
+             * @returns An inferer.
+             */
+            DLInferer *acquire();
+
+            /**
+             * Returns an instance obtained through acquire() or tryAcquire()
+             * to the pool.
+             *
+             * @param inferer Inferer to release
+             */
+            void release(DLInferer *inferer);
+
+            /**
+             * Runs the model on any idle instance.
+             *
+             * @param inputs Input buffers to set for inference run
+             * @param outputs Output buffers to set for inference run
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t run(const VecDlTensorPtr &inputs,
+                        VecDlTensorPtr       &outputs);
+
+            /**
+             * Returns the number of instances in the pool.
+             */
+            int32_t getNumInstances() const;
+
+            /**
+             * Returns the input information of the model.
+             */
+            const VecDlTensor *getInputInfo();
+
+            /**
+             * Returns the output information of the model.
+             */
+            const VecDlTensor *getOutputInfo();
+
+            /**
+             * Creates buffers usable with any instance of the pool. Please
+             * refer to DLInferer::createBuffers().
+             */
+            int32_t createBuffers(const VecDlTensor    *ifInfoList,
+                                  VecDlTensorPtr        &vecVar,
+                                  bool                  allocate);
+
+            /**
+             * Destructor. All the instances must have been released.
+             */
+            ~InfererPool();
+
+        private:
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            InfererPool & operator=(const InfererPool& rhs) = delete;
+
+            /** Creates the instances. */
+            void init(const InfererConfig &config, int32_t numInstances);
+
+            /** Pushes the instance at 'index' on the free-list. */
+            void push(int32_t index);
+
+            /** Pops an instance index from the free-list, -1 if empty. */
+            int32_t pop();
+
+        private:
+            /** Inferer instances. */
+            std::vector<DLInferer *>                m_inferers;
+
+            /** Free-list links. Entry i holds the index + 1 of the instance
+             *  following instance i in the free-list, 0 terminates the list.
+             */
+            std::unique_ptr<std::atomic<uint32_t>[]> m_next;
+
+            /** Head of the free-list. The lower 32 bits hold the index + 1
+             *  of the first idle instance and the upper 32 bits hold a
+             *  version tag that is bumped on every update to avoid the ABA
+             *  problem.
+             */
+            std::atomic<uint64_t>                   m_head{0};
+
+            /** Number of threads sleeping in acquire(). release() only
+             *  signals when there are some, which keeps the uncontended path
+             *  lock-free.
+             */
+            std::atomic<uint32_t>                   m_numWaiters{0};
+
+            /** Mutex paired with m_waitCv. */
+            std::mutex                              m_waitMutex;
+
+            /** Signaled when an instance is released. */
+            std::condition_variable                 m_waitCv;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_POOL_
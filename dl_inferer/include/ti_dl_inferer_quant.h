@@ -0,0 +1,184 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_QUANT_)
+#define _TI_DL_INFERER_QUANT_
+
+/* Standard headers. */
+#include <stdint.h>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+
+/**
+ * \defgroup group_dl_inferer_quant Quantized tensor helpers
+ *
+ * \brief Access to the real values of quantized tensors. The element wise
+ *        helpers let decoders dequantize only the values they use and
+ *        compare thresholds against the stored values directly. The bulk
+ *        routines use NEON on Arm64 for the 8 bit types. Tensors that are
+ *        not quantized are read as they are.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * Returns the scale and the zero point that apply to an element.
+     *
+     * @param t Tensor
+     * @param index Index of the element, in packed order
+     * @param scale Scale, 1 if the tensor is not quantized
+     * @param zeroPoint Zero point, 0 if the tensor is not quantized
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    void getQuantParams(const DlTensor &t,
+                        int64_t         index,
+                        float          &scale,
+                        int32_t        &zeroPoint);
+
+    /**
+     * Returns the stored value of an element, without dequantization.
+     *
+     * @param t Tensor
+     * @param index Index of the element, in packed order
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    float getRawValue(const DlTensor &t, int64_t index);
+
+    /**
+     * Returns the real value of an element.
+     *
+     * @param t Tensor
+     * @param index Index of the element, in packed order
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    float getValue(const DlTensor &t, int64_t index);
+
+    /**
+     * Maps a threshold on the real values of an element to its stored
+     * values, such that getRawValue() > result if and only if
+     * getValue() > threshold.
+     *
+     * @param t Tensor
+     * @param index Index of the element, in packed order
+     * @param threshold Threshold on the real values
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    float quantizeThreshold(const DlTensor &t, int64_t index, float threshold);
+
+    /**
+     * Returns the stored value representing a real value, rounded to the
+     * nearest value and saturated to the range of the type.
+     *
+     * @param t Tensor
+     * @param index Index of the element, in packed order
+     * @param value Real value
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    float quantizeValue(const DlTensor &t, int64_t index, float value);
+
+    /**
+     * Converts a range of elements to their real values.
+     *
+     * @param t Tensor
+     * @param begin Index of the first element, in packed order
+     * @param count Number of elements
+     * @param dst Output array of 'count' entries
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    void dequantize(const DlTensor &t,
+                    int64_t         begin,
+                    int64_t         count,
+                    float          *dst);
+
+    /**
+     * Dequantizes an array of signed 8 bit values.
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    void dequantize(const int8_t   *src,
+                    float          *dst,
+                    int64_t         numElem,
+                    float           scale,
+                    int32_t         zeroPoint);
+
+    /**
+     * Dequantizes an array of unsigned 8 bit values.
+     *
+     * \ingroup group_dl_inferer_quant
+     */
+    void dequantize(const uint8_t  *src,
+                    float          *dst,
+                    int64_t         numElem,
+                    float           scale,
+                    int32_t         zeroPoint);
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_QUANT_
@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_REGISTRY_)
+#define _TI_DL_INFERER_REGISTRY_
+
+/* Standard headers. */
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * \defgroup group_dl_inferer_registry Shared model registry
+ *
+ * \brief Process wide registry of the runtime objects that several inferer
+ *        instances of the same model can share, such as the parsed model
+ *        and the runtime environment. Sharing them keeps a single copy of
+ *        the weights in memory however many instances are created.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * \brief Registry of shared runtime objects, keyed by a string built by
+     *        the backend from the model path and the settings that affect
+     *        the object. The registry only holds weak references, hence an
+     *        object is released along with the last inferer using it.
+     *
+     * \ingroup group_dl_inferer_registry
+     */
+    class DlModelRegistry
+    {
+        public:
+            /**
+             * Returns the process wide registry instance.
+             */
+            static DlModelRegistry &getInstance();
+
+            /**
+             * Returns the object registered under 'key', creating it with
+             * 'create' if there is none alive. Concurrent calls for the same
+             * key wait for the first one to create the object, while calls
+             * for other keys proceed in parallel. A null object returned by
+             * 'create' is not registered.
+             *
+             * @param key Key of the object. The backends prefix it with
+             *            their name, which also tells the type of the object
+             * @param create Callable returning a std::shared_ptr<T>
+             *
+             * @returns The shared object. A nullptr if creation failed.
+             */
+            template <typename T, typename F>
+            std::shared_ptr<T> getOrCreate(const std::string   &key,
+                                           F                  &&create)
+            {
+                std::shared_ptr<Entry>          entry = getEntry(key);
+                std::unique_lock<std::mutex>    lock(entry->mutex);
+                std::shared_ptr<void>           obj = entry->object.lock();
+
+                if (obj == nullptr)
+                {
+                    std::shared_ptr<T>  created = create();
+
+                    entry->object = created;
+
+                    return created;
+                }
+
+                return std::static_pointer_cast<T>(obj);
+            }
+
+            /**
+             * Returns the number of references to the object registered
+             * under 'key', 0 if there is none alive.
+             *
+             * @param key Key of the object
+             */
+            int64_t getUseCount(const std::string &key);
+
+            /**
+             * Dumps the objects alive and their number of references.
+             */
+            void dumpInfo();
+
+        private:
+            /** An object and the lock serializing its creation. */
+            struct Entry
+            {
+                /** Serializes the creation of the object. */
+                std::mutex              mutex;
+
+                /** The object, if alive. */
+                std::weak_ptr<void>     object;
+            };
+
+            /** Constructor. */
+            DlModelRegistry() = default;
+
+            /** Returns the entry of 'key', adding it if missing. */
+            std::shared_ptr<Entry> getEntry(const std::string &key);
+
+        private:
+            /** Protects the map of entries. */
+            std::mutex                                      m_mutex;
+
+            /** Entries, by key. */
+            std::map<std::string, std::shared_ptr<Entry>>   m_entries;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_REGISTRY_
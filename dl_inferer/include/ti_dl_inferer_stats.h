@@ -0,0 +1,222 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_STATS_)
+#define _TI_DL_INFERER_STATS_
+
+/* Standard headers. */
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+/**
+ * \defgroup group_dl_inferer_stats Latency statistics
+ *
+ * \brief Per-call latency recording into log-linear histograms, in the
+ *        spirit of HDR histograms. Each power of two range of nano-seconds
+ *        is split into 16 buckets, which bounds the error on the reported
+ *        percentiles to about 3%. Recording only takes relaxed atomic
+ *        increments and can be done from any thread without locking.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * \brief Summary of the latencies recorded by a DlLatencyHistogram.
+     *
+     * \ingroup group_dl_inferer_stats
+     */
+    struct DlLatencyStats
+    {
+        /** Number of calls recorded. */
+        uint64_t    count{};
+
+        /** Mean latency in milli-seconds. */
+        double      meanMs{};
+
+        /** Median latency in milli-seconds. */
+        double      p50Ms{};
+
+        /** 90th percentile latency in milli-seconds. */
+        double      p90Ms{};
+
+        /** 99th percentile latency in milli-seconds. */
+        double      p99Ms{};
+
+        /** Maximum latency in milli-seconds. */
+        double      maxMs{};
+
+        /** Calls per second, between the start of the first call and the
+         *  end of the last one.
+         */
+        double      callsPerSec{};
+    };
+
+    /**
+     * \brief Lock-free latency histogram.
+     *
+     * \ingroup group_dl_inferer_stats
+     */
+    class DlLatencyHistogram
+    {
+        public:
+            /** Constructor. */
+            DlLatencyHistogram();
+
+            /**
+             * Returns the current time in nano-seconds of the monotonic
+             * clock used for the measurements.
+             */
+            static uint64_t now();
+
+            /**
+             * Records one call.
+             *
+             * @param latencyNs Duration of the call in nano-seconds
+             */
+            void record(uint64_t latencyNs);
+
+            /**
+             * Returns the summary of the calls recorded since the creation
+             * or the last reset.
+             */
+            DlLatencyStats getStats() const;
+
+            /**
+             * Clears the recorded calls. The calls recorded concurrently
+             * with a reset may be partially accounted.
+             */
+            void reset();
+
+            /**
+             * Dumps the summary to the screen.
+             *
+             * @param label Name of the measured stage
+             */
+            void dumpInfo(const std::string &label) const;
+
+        private:
+            /** Number of buckets per power of two, as a shift. */
+            static constexpr int32_t    SUB_BUCKET_BITS = 4;
+
+            /** Number of buckets covering the whole 64 bit range. */
+            static constexpr int32_t    NUM_BUCKETS =
+                (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+            /** Returns the bucket of a value. */
+            static int32_t getBucket(uint64_t value);
+
+            /** Returns the value in the middle of a bucket. */
+            static uint64_t getBucketValue(int32_t bucket);
+
+            /** Number of calls per bucket. */
+            std::atomic<uint64_t>   m_buckets[NUM_BUCKETS];
+
+            /** Number of calls. */
+            std::atomic<uint64_t>   m_count;
+
+            /** Sum of the latencies in nano-seconds. */
+            std::atomic<uint64_t>   m_sumNs;
+
+            /** Maximum latency in nano-seconds. */
+            std::atomic<uint64_t>   m_maxNs;
+
+            /** Start of the first call, 0 if none. */
+            std::atomic<uint64_t>   m_firstNs;
+
+            /** End of the last call. */
+            std::atomic<uint64_t>   m_lastNs;
+    };
+
+    /**
+     * \brief Records the lifetime of the object into a histogram.
+     *
+     * \ingroup group_dl_inferer_stats
+     */
+    class DlLatencyScope
+    {
+        public:
+            /** Constructor. Starts the measurement. */
+            DlLatencyScope(DlLatencyHistogram &histogram):
+                m_histogram(histogram),
+                m_start(DlLatencyHistogram::now())
+            {
+            }
+
+            /** Destructor. Records the measurement. */
+            ~DlLatencyScope()
+            {
+                m_histogram.record(DlLatencyHistogram::now() - m_start);
+            }
+
+        private:
+            /** Histogram to record into. */
+            DlLatencyHistogram &m_histogram;
+
+            /** Start of the measurement. */
+            uint64_t            m_start;
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_DL_INFERER_STATS_
@@ -0,0 +1,267 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_DL_INFERER_TRACE_)
+#define _TI_DL_INFERER_TRACE_
+
+/* Standard headers. */
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_stats.h>
+
+/**
+ * \defgroup group_dl_inferer_trace Timeline tracing
+ *
+ * \brief Scoped spans recorded into per-thread ring buffers and exported in
+ *        the Chrome trace event format, which chrome://tracing and Perfetto
+ *        can open. The spans are compiled in when USE_DL_INFER_TRACE is
+ *        defined and cost a single relaxed load while tracing is disabled
+ *        at run time. Setting the DL_INFER_TRACE environment variable to a
+ *        file name enables tracing at start-up and dumps the trace to that
+ *        file at exit.
+ *
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /**
+     * \brief Process wide trace recorder.
+     *
+     * \ingroup group_dl_inferer_trace
+     */
+    class DlTracer
+    {
+        public:
+            /** Number of spans kept per thread. The oldest spans are
+             *  overwritten when a thread records more than this.
+             */
+            static constexpr uint32_t   RING_SIZE = 8192;
+
+            /**
+             * Returns the process wide tracer instance.
+             */
+            static DlTracer &getInstance();
+
+            /**
+             * Returns true if the spans are being recorded.
+             */
+            bool isEnabled() const
+            {
+                return m_enabled.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * Starts or stops recording the spans.
+             */
+            void enable(bool enable);
+
+            /**
+             * Records a span on the calling thread.
+             *
+             * @param name Name of the span. This must be a string literal or
+             *             otherwise outlive the tracer.
+             * @param startNs Start of the span in nano-seconds, see
+             *                DlLatencyHistogram::now()
+             * @param endNs End of the span in nano-seconds
+             */
+            void record(const char *name, uint64_t startNs, uint64_t endNs);
+
+            /**
+             * Writes the recorded spans as Chrome trace event JSON. The
+             * spans recorded while dumping may be left out, as well as the
+             * ones being overwritten.
+             *
+             * @param fileName Output file
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t dump(const std::string &fileName);
+
+            /**
+             * Drops the recorded spans.
+             */
+            void clear();
+
+        private:
+            /** A recorded span. The fields are only written by the
+             *  thread owning the ring and read by dump().
+             */
+            struct Span
+            {
+                /** Index of the span in the ring plus one once written,
+                 *  0 while being written.
+                 */
+                std::atomic<uint64_t>       seq{0};
+                std::atomic<const char *>   name{nullptr};
+                std::atomic<uint64_t>       startNs{0};
+                std::atomic<uint64_t>       endNs{0};
+            };
+
+            /** Ring of spans written by a single thread at a time. */
+            struct ThreadRing
+            {
+                /** Thread Id reported in the trace. Protected by m_mutex. */
+                int32_t                 tid;
+
+                /** Number of spans ever written. */
+                std::atomic<uint64_t>   head{0};
+
+                /** Value of 'head' at the last clear(). */
+                std::atomic<uint64_t>   tail{0};
+
+                /** Spans. */
+                Span                    spans[RING_SIZE];
+            };
+
+            /** Constructor. Use getInstance() to access the tracer. */
+            DlTracer() = default;
+
+            /** Returns the ring of the calling thread, taking one if needed.
+             *  Returns null once the thread-local storage of the thread is
+             *  being destroyed.
+             */
+            ThreadRing *getThreadRing();
+
+            /** Takes a ring from the free list or creates one. */
+            ThreadRing *acquireThreadRing();
+
+            /** Returns the ring of an exiting thread to the free list. */
+            void releaseThreadRing(ThreadRing *ring);
+
+            /** Recording enabled. */
+            std::atomic<bool>                           m_enabled{false};
+
+            /** Mutex protecting the list of rings. */
+            std::mutex                                  m_mutex;
+
+            /** All the rings. The ring of an exiting thread keeps its
+             *  spans, so that these can be dumped, until a new thread
+             *  takes it. The number of rings hence follows the number of
+             *  threads recording at the same time.
+             */
+            std::vector<std::unique_ptr<ThreadRing>>    m_rings;
+
+            /** Rings of the exited threads. */
+            std::vector<ThreadRing *>                   m_freeRings;
+    };
+
+    /**
+     * \brief Records the lifetime of the object as a span, if tracing is
+     *        enabled when the object is created.
+     *
+     * \ingroup group_dl_inferer_trace
+     */
+    class DlTraceScope
+    {
+        public:
+            /** Constructor. Starts the span. */
+            DlTraceScope(const char *name)
+            {
+                if (DlTracer::getInstance().isEnabled())
+                {
+                    m_name  = name;
+                    m_start = DlLatencyHistogram::now();
+                }
+            }
+
+            /** Destructor. Records the span. */
+            ~DlTraceScope()
+            {
+                if (m_name != nullptr)
+                {
+                    DlTracer::getInstance().record(m_name, m_start,
+                                                   DlLatencyHistogram::now());
+                }
+            }
+
+        private:
+            /** Name of the span, null if tracing is disabled. */
+            const char *m_name{nullptr};
+
+            /** Start of the span. */
+            uint64_t    m_start{};
+    };
+
+} // namespace ti::dl_inferer
+
+#define DL_INFER_TRACE_CONCAT_(a, b)    a##b
+#define DL_INFER_TRACE_CONCAT(a, b)     DL_INFER_TRACE_CONCAT_(a, b)
+
+/**
+ * \brief Records the rest of the enclosing scope as a span named 'name'.
+ *        This compiles to nothing unless USE_DL_INFER_TRACE is defined.
+ * \ingroup group_dl_inferer_trace
+ */
+#if defined(USE_DL_INFER_TRACE)
+#define DL_INFER_TRACE_SCOPE(name) \
+    ti::dl_inferer::DlTraceScope DL_INFER_TRACE_CONCAT(_dlTraceScope, __LINE__)(name)
+#else
+#define DL_INFER_TRACE_SCOPE(name)
+#endif
+
+#endif // _TI_DL_INFERER_TRACE_
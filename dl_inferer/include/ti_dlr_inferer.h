@@ -115,6 +115,8 @@ namespace ti::dl_inferer
             virtual int32_t run(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs);
 
+            using DLInferer::run;
+
             /**
              * Dumps the model information to the screen.
              */
@@ -137,12 +139,10 @@ namespace ti::dl_inferer
             virtual const VecDlTensor *getOutputInfo();
 
             /**
-             * Returns an allocated pointer that can be consumed by inference
-             * of the model by this framework.
-             *
-             * @returns An pointer to allocated memory.
+             * Returns the alignment in bytes the runtime expects for the
+             * data buffers.
              */
-            virtual void *allocate(int64_t size) override;
+            virtual int32_t getBufferAlignment() override;
 
             /**
              * Destructor
@@ -171,6 +171,21 @@ namespace ti::dl_inferer
             /** A list of output interface details. */
             VecDlTensor                 m_outputs;
 
+            /** Staging buffers for packing the strided inputs. */
+            VecDlTensor                 m_packedInputs;
+
+            /** Input data pointers currently bound to the model. */
+            std::vector<void *>         m_boundInputs;
+
+        protected:
+            /**
+             * Binds the inputs to the model for zero-copy, skipping the ones
+             * already bound. The outputs are copied out after every run and
+             * hence need no binding.
+             */
+            virtual int32_t bindBuffers(const VecDlTensorPtr &inputs,
+                                        VecDlTensorPtr       &outputs) override;
+
         private:
             /**
              * Quesries the model and extracts the details of the input parameters.
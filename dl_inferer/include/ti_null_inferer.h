@@ -0,0 +1,222 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#if !defined(_TI_NULL_INFERER_)
+#define _TI_NULL_INFERER_
+
+/* Standard headers. */
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <random>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+
+/**
+ * \defgroup group_null_inferer Synthetic inferer
+ *
+ * \brief A class mimicking the interface and timing of a model without
+ *        running anything. This allows profiling the pre-processing,
+ *        post-processing and the application pipeline on hosts without the
+ *        runtime libraries.
+ * \ingroup group_dl_inferer
+ */
+
+namespace ti::dl_inferer
+{
+    /** \brief A concrete class for the synthetic inferer.
+     *
+     * \ingroup group_null_inferer
+     */
+    class NullInferer: public DLInferer
+    {
+        public:
+            /**
+             * Constructor.
+             *
+             * @param spec Description of the interface, timing and output
+             *             contents to simulate.
+             * @param shareModel Share the synthetic weights with the other
+             *                   instances having the same weights size
+             *                   and seed.
+             */
+            NullInferer(const NullInfererSpec &spec, bool shareModel = true);
+
+            /**
+             * Fills the outputs as per the configuration after the
+             * configured latency. The inputs are not looked at.
+             *
+             * @param inputs Input buffers to set for inference run
+             * @param outputs Output buffers to set for inference run
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            virtual int32_t run(const VecDlTensorPtr &inputs,
+                                VecDlTensorPtr       &outputs);
+
+            using DLInferer::run;
+
+            /**
+             * Runs the frames as one batch when the leading dimension of
+             * every input is dynamic and the outputs hold one frame. Please
+             * refer to DLInferer::runBatch().
+             */
+            virtual int32_t runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                                     std::vector<VecDlTensorPtr>       &outputs) override;
+
+            /**
+             * Dumps the model information to the screen.
+             */
+            virtual void dumpInfo();
+
+            /**
+             * Returns a pointer to an array containing detailed information on
+             * the inputs of the model.
+             *
+             * @returns A pointer to an array of input interface parameters.
+             */
+            virtual const VecDlTensor *getInputInfo();
+
+            /**
+             * Returns a pointer to an array containing detailed information on
+             * the outputs of the model.
+             *
+             * @returns A pointer to an array of output interface parameters.
+             */
+            virtual const VecDlTensor *getOutputInfo();
+
+            /**
+             * Returns DlConcurrency_Concurrent if the specification asks
+             * for it.
+             */
+            virtual DlConcurrency getConcurrency() override;
+
+            /**
+             * Destructor
+             */
+            ~NullInferer();
+
+        private:
+            /** Configuration. */
+            NullInfererSpec                         m_spec;
+
+            /** A list of input interface details. */
+            VecDlTensor                             m_inputs;
+
+            /** A list of output interface details. */
+            VecDlTensor                             m_outputs;
+
+            /** Width of the first input, used for the detection boxes. */
+            float                                   m_width{1.0f};
+
+            /** Height of the first input, used for the detection boxes. */
+            float                                   m_height{1.0f};
+
+            /** Random generator for the jitter and the output contents. */
+            std::mt19937                            m_rng;
+
+            /** Serializes the output generation of the concurrent calls. */
+            std::mutex                              m_fillMutex;
+
+            /** Synthetic weights. */
+            std::shared_ptr<std::vector<uint8_t>>   m_weights;
+
+            /** Frames can be packed along the leading dimension. */
+            bool                                    m_dynamicBatch{false};
+
+            /** Packed inputs of runBatch(). */
+            VecDlTensor                             m_batchInputs;
+
+            /** Batched outputs of runBatch(). */
+            VecDlTensor                             m_batchOutputs;
+
+            /** Packed copy of a strided first input for the echo fill. */
+            DlTensor                                m_echoInput;
+
+        private:
+            /**
+             * Creates the interface details from the specification.
+             *
+             * @param specs Tensor specifications
+             * @param vec Receives the interface details
+             * @param allowDynamic Accept negative dimensions, which leave
+             *                     the size unknown
+             *
+             * @returns 0 upon success. A negative value otherwise.
+             */
+            int32_t populateInfo(const std::vector<NullTensorSpec> &specs,
+                                 VecDlTensor                       &vec,
+                                 bool                               allowDynamic);
+
+            /**
+             * Fills an output buffer as per the configuration.
+             *
+             * @param tensor Output to fill
+             * @param echo Packed data of the first input, for the echo fill
+             * @param echoSize Size of 'echo' in bytes
+             */
+            void fillOutput(DlTensor *tensor, const void *echo, int64_t echoSize);
+    };
+
+} // namespace ti::dl_inferer
+
+#endif // _TI_NULL_INFERER_
@@ -64,6 +64,8 @@
 
 /* Standard headers. */
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 /* Third-party headers. */
@@ -94,10 +96,21 @@ namespace ti::dl_inferer
              * @param modelPath Path to the model.
              * @param artifactPath Path to the directory containing the model
              *                     artifacts.
+             * @param enableTidl Offload to TIDL
+             * @param enableModelCache Save the optimized graph and load it on
+             *                         the later starts. This is ignored when
+             *                         offloading to TIDL.
+             * @param cpuTuning Threading settings of the session.
+             * @param shareModel Share the session with the other instances
+             *                   of the same model and settings. This is
+             *                   ignored when offloading to TIDL.
              */
             ORTInferer(const std::string &modelPath,
                        const std::string &artifactPath,
-                       bool               enableTidl);
+                       bool               enableTidl,
+                       bool               enableModelCache = false,
+                       const CpuTuning   &cpuTuning = CpuTuning(),
+                       bool               shareModel = true);
 
             /**
              * Runs the model. This should be called only after all the inputs
@@ -111,6 +124,16 @@ namespace ti::dl_inferer
             virtual int32_t run(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs);
 
+            using DLInferer::run;
+
+            /**
+             * Runs the model on a batch of frames. The frames are packed
+             * into a single run if the leading dimension of all the inputs
+             * is dynamic. Please refer to DLInferer::runBatch().
+             */
+            virtual int32_t runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                                     std::vector<VecDlTensorPtr>       &outputs) override;
+
             /**
              * Dumps the model information to the screen.
              */
@@ -132,7 +155,12 @@ namespace ti::dl_inferer
              */
             virtual const VecDlTensor *getOutputInfo();
 
-            virtual void *allocate(int64_t size) override;
+            /**
+             * Returns DlConcurrency_Concurrent unless the model is offloaded
+             * to TIDL. The runtime session can be run from several threads
+             * as long as every call owns its buffers.
+             */
+            virtual DlConcurrency getConcurrency() override;
 
             /**
              * Destructor
@@ -140,6 +168,40 @@ namespace ti::dl_inferer
             ~ORTInferer();
 
         private:
+            /** Storage of a copying run, reused across runs so that these
+             *  do not allocate once warmed up.
+             */
+            struct RunScratch
+            {
+                /** Input values. An entry is only recreated when the
+                 *  buffer or the shape it refers to changes.
+                 */
+                std::vector<Ort::Value>             inputValues;
+
+                /** Input data pointers the values refer to. */
+                std::vector<const void *>           inputData;
+
+                /** Input shapes the values refer to. */
+                std::vector<std::vector<int64_t>>   inputShapes;
+
+                /** Output values, runtime allocated unless written in
+                 *  place.
+                 */
+                std::vector<Ort::Value>             outputValues;
+
+                /** Output data pointers the in place values refer to. */
+                std::vector<void *>                 outputData;
+
+                /** Set for the outputs written in place. */
+                std::vector<uint8_t>                inPlace;
+
+                /** Staging buffers for packing the strided inputs. */
+                VecDlTensor                         staging;
+
+                /** Shape of a copied output. */
+                std::vector<int64_t>                shape;
+            };
+
             /** Path to the model. */
             std::string                             m_modelPath;
 
@@ -149,12 +211,17 @@ namespace ti::dl_inferer
             /** Enable TIDL. */
             bool                                    m_enableTidl;
 
-            /** Environment setup. */
-            Ort::Env                                m_env;
+            /** Enable the optimized model cache. */
+            bool                                    m_enableModelCache;
+
+            /** Environment setup, shared by all the instances. */
+            std::shared_ptr<Ort::Env>               m_env;
 
-            /** Handle to the model inference engine. */
-            //Ort::Experimental::Session             *m_session{nullptr};
-            Ort::Session                           *m_session{nullptr};
+            /** Handle to the model inference engine. Run() is thread safe
+             *  and each instance binds its own buffers, hence the session
+             *  may be shared with other instances.
+             */
+            std::shared_ptr<Ort::Session>           m_session;
 
             /** Input node types. */
             std::vector<ONNXTensorElementDataType>  m_inputTypes;
@@ -177,6 +244,11 @@ namespace ti::dl_inferer
             /** Memory information object. */
             Ort::MemoryInfo                         m_memInfo;
 
+            /** Options passed to every run. Created once since creating
+             *  them allocates.
+             */
+            Ort::RunOptions                         m_runOpts;
+
             /** Memoer allocator. */
             Ort::AllocatorWithDefaultOptions        m_allocator;
 
@@ -186,6 +258,81 @@ namespace ti::dl_inferer
             /** A list of output interface details. */
             VecDlTensor                             m_outputs;
 
+            /** Staging buffers for packing the strided inputs. */
+            VecDlTensor                             m_packedInputs;
+
+            /** Set if the leading dimension of all the inputs is dynamic. */
+            bool                                    m_dynamicBatch{false};
+
+            /** Staging buffers holding the packed inputs of a batch. The
+             *  'size' field holds the capacity of the buffer, which only
+             *  grows.
+             */
+            VecDlTensor                             m_batchInputs;
+
+            /** Persistent binding of the run() buffers. It is dropped when
+             *  a zero-copy run fails and rebuilt on the next run.
+             */
+            std::unique_ptr<Ort::IoBinding>         m_binding;
+
+            /** The runtime supports IoBinding. */
+            bool                                    m_bindingSupported{false};
+
+            /** Input data pointers currently bound. */
+            std::vector<void *>                     m_boundInputs;
+
+            /** Output data pointers currently bound. A null entry means the
+             *  output is bound to memory allocated by ONNX Runtime and gets
+             *  copied out after the run.
+             */
+            std::vector<void *>                     m_boundOutputs;
+
+            /** Shapes of the inputs currently bound. */
+            std::vector<std::vector<int64_t>>       m_boundShapes;
+
+            /** Shapes of the outputs currently bound in place. */
+            std::vector<std::vector<int64_t>>       m_boundOutputShapes;
+
+            /** Last shape of each output whose shape is not known from the
+             *  model.
+             */
+            std::vector<std::vector<int64_t>>       m_lastShapes;
+
+            /** Set for the outputs not known from the model whose last two
+             *  runs gave the same shape. These are bound in place with that
+             *  shape.
+             */
+            std::vector<uint8_t>                    m_shapeStable;
+
+            /** Scratch storage for the shape of a copied output. */
+            std::vector<int64_t>                    m_shape;
+
+            /** Scratch storage of run_memcopy(). */
+            RunScratch                              m_runScratch;
+
+            /** Mutex protecting the concurrent run scratch lists. */
+            std::mutex                              m_scratchMutex;
+
+            /** Scratch storage of the concurrent runs, one per thread
+             *  that ran concurrently at some point.
+             */
+            std::vector<std::unique_ptr<RunScratch>>    m_scratch;
+
+            /** Concurrent run scratch storage not in use. */
+            std::vector<RunScratch *>               m_freeScratch;
+
+        protected:
+            /**
+             * Binds the buffers to the persistent IoBinding, skipping the
+             * ones already bound. An output whose shape is not known from
+             * the model is bound in place once its shape is stable, after
+             * growing its buffer to that shape. Until then, and for the
+             * outputs whose buffer is too small, the output is bound to
+             * runtime allocated memory and copied after the run.
+             */
+            virtual int32_t bindBuffers(const VecDlTensorPtr &inputs,
+                                        VecDlTensorPtr       &outputs) override;
+
         private:
             /**
              * Quesries the model and extracts the details of the input parameters.
@@ -201,11 +348,77 @@ namespace ti::dl_inferer
              */
             int32_t populateOutputInfo();
 
+            /**
+             * Returns the path of the optimized model cache entry for the
+             * model, the runtime version and the given session options.
+             *
+             * @param options String describing the session options
+             *
+             * @returns The path upon success. An empty string if the model
+             *          cannot be read or the directory is not writable.
+             */
+            std::string getModelCachePath(const std::string &options);
+
+            /**
+             * Creates the persistent binding with all the outputs bound to
+             * runtime allocated memory.
+             *
+             * @returns 0 upon success. A negative value otherwise.
+             */
+            int32_t createBinding();
+
+            /**
+             * Sizes the scratch storage for the model and points its input
+             * values to the given inputs, packing the strided ones.
+             */
+            void setInputValues(const VecDlTensorPtr &inputs,
+                                RunScratch           &scratch);
+
+            /** Takes concurrent run scratch storage off the free list. */
+            RunScratch *acquireScratch();
+
+            /** Returns concurrent run scratch storage to the free list. */
+            void releaseScratch(RunScratch *scratch);
+
+            /**
+             * Records the shape of an output that is not known from the
+             * model, as produced by a run holding the instance.
+             */
+            void updateOutputShape(uint32_t index, const DlTensor *info);
+
+            /**
+             * Runs the model on the buffers bound through m_binding. Only
+             * the outputs bound to runtime allocated memory are copied. A
+             * failed run is repeated through run_memcopy() and the binding
+             * is rebuilt on the next run.
+             */
             int32_t run_zerocopy(const VecDlTensorPtr &inputs,
                                  VecDlTensorPtr       &outputs);
 
+            /**
+             * Runs the model letting the runtime allocate all the outputs
+             * and copies them.
+             */
             int32_t run_memcopy(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs);
+
+            /**
+             * Runs the model while another call holds the instance. The
+             * buffers are bound for this call only and the strided inputs
+             * are packed into local staging buffers, leaving the instance
+             * state untouched.
+             */
+            int32_t run_concurrent(const VecDlTensorPtr &inputs,
+                                   VecDlTensorPtr       &outputs);
+
+            /**
+             * Copies a runtime allocated output into 'info', updating its
+             * shape and growing its buffer when needed. 'shape' is scratch
+             * storage for the output dimensions.
+             */
+            void copyOutput(Ort::Value            &tensor,
+                            DlTensor              *info,
+                            std::vector<int64_t>  &shape);
     };
 
 } // namespace ti::dl_inferer
@@ -62,6 +62,9 @@
 #if !defined(_TI_TFLITE_INFERER_)
 #define _TI_TFLITE_INFERER_
 
+/* Standard headers. */
+#include <list>
+
 /* Third-party headers. */
 #include <tensorflow/lite/model.h>
 #include <tensorflow/lite/interpreter.h>
@@ -92,10 +95,20 @@ namespace ti::dl_inferer
              * @param modelPath Path to the model.
              * @param artifactPath Path to the directory containing the model
              *                     artifacts.
+             * @param enableTidl Offload to TIDL
+             * @param cpuTuning Threading settings of the interpreter.
+             * @param shapeCacheSize Maximum number of input shapes kept
+             *                       planned for a model with dynamic
+             *                       input dimensions.
+             * @param shareModel Share the parsed model with the other
+             *                   instances of the same model.
              */
             TFLiteInferer(const std::string &modelPath,
                           const std::string &artifactPath,
-                          bool               enableTidl);
+                          bool               enableTidl,
+                          const CpuTuning   &cpuTuning = CpuTuning(),
+                          int32_t            shapeCacheSize = 4,
+                          bool               shareModel = true);
 
             /**
              * Runs the model. This should be called only after all the inputs
@@ -109,6 +122,16 @@ namespace ti::dl_inferer
             virtual int32_t run(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs);
 
+            using DLInferer::run;
+
+            /**
+             * Runs the model on a batch of frames. The frames are packed
+             * into a single invocation if the leading dimension of all the
+             * inputs is dynamic. Please refer to DLInferer::runBatch().
+             */
+            virtual int32_t runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                                     std::vector<VecDlTensorPtr>       &outputs) override;
+
             /**
              * Dumps the model information to the screen.
              */
@@ -131,12 +154,10 @@ namespace ti::dl_inferer
             virtual const VecDlTensor *getOutputInfo();
 
             /**
-             * Returns an allocated pointer that can be consumed by inference
-             * of the model by this framework.
-             *
-             * @returns An pointer to allocated memory.
+             * Returns the alignment in bytes the runtime expects for the
+             * data buffers.
              */
-            virtual void *allocate(int64_t size) override;
+            virtual int32_t getBufferAlignment() override;
 
             /**
              * Destructor
@@ -153,8 +174,10 @@ namespace ti::dl_inferer
             /** Enable TIDL. */
             bool                                        m_enableTidl;
 
-            /**  A pointer to the model representation in memory. */
-            std::unique_ptr<tflite::FlatBufferModel>    m_model;
+            /**  A pointer to the model representation in memory. It is
+             *   read-only and may be shared with other instances.
+             */
+            std::shared_ptr<tflite::FlatBufferModel>    m_model;
 
             /** TODO. */
             tflite::ops::builtin::BuiltinOpResolver     m_resolver;
@@ -174,6 +197,80 @@ namespace ti::dl_inferer
             /** A list of output interface details. */
             VecDlTensor                                 m_outputs;
 
+            /** Staging buffers for packing the strided inputs. */
+            VecDlTensor                                 m_packedInputs;
+
+            /** Set if the leading dimension of all the inputs is dynamic. */
+            bool                                        m_dynamicBatch{false};
+
+            /** Batch size the interpreter tensors are currently sized for. */
+            int32_t                                     m_batchSize{1};
+
+            /** Staging buffers holding the packed inputs of a batch. The
+             *  'size' field holds the capacity of the buffer, which only
+             *  grows.
+             */
+            VecDlTensor                                 m_batchInputs;
+
+            /** Staging buffers receiving the batched outputs. */
+            VecDlTensor                                 m_batchOutputs;
+
+            /** Input data pointers currently set as custom allocations. */
+            std::vector<void *>                         m_boundInputs;
+
+            /** Output data pointers currently set as custom allocations. */
+            std::vector<void *>                         m_boundOutputs;
+
+            /** Number of threads of the interpreters. The runtime default
+             *  is used if 0.
+             */
+            int32_t                                     m_numThreads;
+
+            /** Set if an input has a dynamic dimension other than the
+             *  leading one.
+             */
+            bool                                        m_dynamicShape{false};
+
+            /** Maximum number of interpreters, each planned for one set of
+             *  input shapes.
+             */
+            uint32_t                                    m_shapeCacheSize;
+
+            /** Input shapes, concatenated, m_interpreter is planned for. */
+            std::vector<int64_t>                        m_shapeKey;
+
+            /** An interpreter planned for a set of input shapes. */
+            struct ShapePlan
+            {
+                /** Input shapes, concatenated. */
+                std::vector<int64_t>                    key;
+
+                /** Interpreter with its tensors allocated for 'key'. */
+                std::unique_ptr<tflite::Interpreter>    interpreter;
+
+                /** Input data pointers set as custom allocations. */
+                std::vector<void *>                     boundInputs;
+
+                /** Output data pointers set as custom allocations. */
+                std::vector<void *>                     boundOutputs;
+            };
+
+            /** Interpreters planned for other shapes than m_interpreter,
+             *  the most recently used first.
+             */
+            std::list<ShapePlan>                        m_shapePlans;
+
+            /** Scratch storage for shapes. */
+            std::vector<int64_t>                        m_shape;
+
+        protected:
+            /**
+             * Sets the buffers as custom allocations of the interpreter
+             * tensors, skipping the ones already set.
+             */
+            virtual int32_t bindBuffers(const VecDlTensorPtr &inputs,
+                                        VecDlTensorPtr       &outputs) override;
+
         private:
             /**
              * Quesries the model and extracts the details of the input parameters.
@@ -188,6 +285,36 @@ namespace ti::dl_inferer
              * @returns 0 upon success. A negative value otherwise.
              */
             int32_t populateOutputInfo();
+
+            /**
+             * Makes m_interpreter the one planned for the shapes of
+             * 'inputs'. An interpreter planned earlier is re-used if cached.
+             * Otherwise a new one is created while the cache is not full,
+             * or else the least recently used one is planned again.
+             *
+             * @returns 0 upon success. A negative value otherwise.
+             */
+            int32_t selectShape(const VecDlTensorPtr &inputs);
+
+            /**
+             * Updates the shape of the outputs from the interpreter and grows
+             * their buffers when needed.
+             */
+            void updateOutputs(VecDlTensorPtr &outputs);
+
+            /**
+             * Exchanges m_interpreter and its bindings with a cached plan.
+             */
+            void swapPlan(ShapePlan &plan);
+
+            /**
+             * Resizes the leading dimension of the inputs and re-allocates
+             * the tensors. The custom allocations in place must be large
+             * enough for the new size.
+             *
+             * @returns 0 upon success. A negative value otherwise.
+             */
+            int32_t setBatchSize(int32_t batchSize);
     };
 
 } // namespace ti::dl_inferer
@@ -61,11 +61,20 @@
  */
 /* Standard headers. */
 #include <string>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <algorithm>
 #include <filesystem>
+#include <pthread.h>
+#include <sched.h>
 
 /* Module headers. */
 #include <ti_dl_inferer.h>
+#include <ti_dl_inferer_buffer_pool.h>
 #include <ti_dl_inferer_logger.h>
+#include <ti_null_inferer.h>
 
 #if defined(USE_DLR_RT)
 #include <ti_dlr_inferer.h>
@@ -108,6 +117,49 @@ using namespace ti::dl_inferer::utils;
 
 namespace ti::dl_inferer
 {
+DlCpuAffinityScope::DlCpuAffinityScope(const std::vector<int32_t> &cores)
+{
+    cpu_set_t   set;
+
+    if (cores.empty())
+    {
+        return;
+    }
+
+    CPU_ZERO(&set);
+
+    for (auto c : cores)
+    {
+        if ((c >= 0) && (c < CPU_SETSIZE))
+        {
+            CPU_SET(c, &set);
+        }
+    }
+
+    if (pthread_getaffinity_np(pthread_self(), sizeof(m_saved),
+                               &m_saved) != 0)
+    {
+        DL_INFER_LOG_WARN("Querying the CPU affinity failed.\n");
+    }
+    else if (pthread_setaffinity_np(pthread_self(), sizeof(set),
+                                    &set) != 0)
+    {
+        DL_INFER_LOG_WARN("Setting the CPU affinity failed.\n");
+    }
+    else
+    {
+        m_restore = true;
+    }
+}
+
+DlCpuAffinityScope::~DlCpuAffinityScope()
+{
+    if (m_restore)
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(m_saved), &m_saved);
+    }
+}
+
 uint8_t getTypeSize(DlInferType type)
 {
     switch (type) {
@@ -134,7 +186,7 @@ DlTensor::DlTensor()
     DL_INFER_LOG_DEBUG("DEFAULT CONSTRUCTOR\n");
 }
 
-DlTensor::DlTensor(const DlTensor& rhs):
+DlTensor::DlTensor(DlTensor&& rhs) noexcept:
     name(rhs.name),
     typeName(rhs.typeName),
     type(rhs.type),
@@ -142,25 +194,146 @@ DlTensor::DlTensor(const DlTensor& rhs):
     numElem (rhs.numElem),
     elemSize(rhs.elemSize),
     dim(rhs.dim),
-    shape(rhs.shape),
-    data(nullptr),
-    dataAllocated(rhs.dataAllocated)
+    shape(std::move(rhs.shape)),
+    strides(std::move(rhs.strides)),
+    layout(rhs.layout),
+    quant(std::move(rhs.quant)),
+    data(rhs.data),
+    buffer(std::move(rhs.buffer)),
+    capacity(rhs.capacity)
 {
-    /* Do not point to the other object's data pointer. It
-     * should be allocated as needed in the current object.
-     */
-    DL_INFER_LOG_DEBUG("COPY CONSTRUCTOR\n");
+    rhs.data = nullptr;
+
+    DL_INFER_LOG_DEBUG("MOVE CONSTRUCTOR\n");
+}
+
+DlTensor DlTensor::cloneInfo() const
+{
+    DlTensor    t;
+
+    t.name     = name;
+    t.typeName = typeName;
+    t.type     = type;
+    t.size     = size;
+    t.numElem  = numElem;
+    t.elemSize = elemSize;
+    t.dim      = dim;
+    t.shape    = shape;
+    t.strides  = strides;
+    t.layout   = layout;
+    t.quant    = quant;
+
+    return t;
+}
+
+DlTensor DlTensor::share() const
+{
+    DlTensor    t = cloneInfo();
+
+    t.data     = data;
+    t.buffer   = buffer;
+    t.capacity = capacity;
+
+    return t;
 }
 
 void DlTensor::allocateDataBuffer(DLInferer& inferer)
 {
-    if (dataAllocated)
+    /* Return the buffer to the pool when the last owner releases it. */
+    buffer.reset(inferer.allocate(size),
+                 [](void *p){ DlBufferPool::getInstance().release(p); });
+    data = buffer.get();
+    capacity = size;
+}
+
+int32_t DlTensor::wrap(void                         *ptr,
+                       int64_t                       bytes,
+                       std::function<void(void *)>   deleter)
+{
+    if (ptr == nullptr)
+    {
+        DL_INFER_LOG_ERROR("Invalid pointer.\n");
+        return -1;
+    }
+
+    int64_t needed = size;
+
+    /* A strided tensor spans from its first to its last element. */
+    if (!strides.empty() && (size > 0))
+    {
+        int64_t last = 0;
+
+        for (size_t d = 0; d < shape.size(); d++)
+        {
+            last += (shape[d] - 1) * strides[d];
+        }
+
+        needed = (last + 1) * elemSize;
+    }
+
+    if ((needed > 0) && (bytes < needed))
+    {
+        DL_INFER_LOG_ERROR("The memory holds %ld bytes, %ld needed.\n",
+                           bytes, needed);
+        return -1;
+    }
+
+    if (deleter)
+    {
+        buffer.reset(ptr, std::move(deleter));
+    }
+    else
+    {
+        buffer.reset(ptr, [](void *){});
+    }
+
+    data     = ptr;
+    capacity = bytes;
+
+    return 0;
+}
+
+void DlTensor::reshape(const std::vector<int64_t>   &newShape,
+                       DLInferer                    &inferer)
+{
+    int64_t avail;
+
+    if ((data != nullptr) && (data == buffer.get()))
+    {
+        avail = capacity;
+    }
+    else
+    {
+        avail = (data != nullptr) ? size : 0;
+    }
+
+    shape   = newShape;
+    dim     = shape.size();
+    numElem = 1;
+
+    strides.clear();
+
+    for (const auto d : shape)
+    {
+        numElem *= d;
+    }
+
+    if (std::any_of(shape.begin(), shape.end(), [](int64_t d){ return d < 0; }))
     {
-        delete [] reinterpret_cast<uint8_t*>(data);
+        numElem = -1;
     }
 
-    data = inferer.allocate(size);
-    dataAllocated = true;
+    size = numElem * elemSize;
+
+    if (size > avail)
+    {
+        allocateDataBuffer(inferer);
+    }
+}
+
+const std::shared_ptr<void> &DlTensor::getBuffer() const
+{
+    return buffer;
 }
 
 void DlTensor::dumpInfo() const
@@ -182,10 +355,114 @@ void DlTensor::dumpInfo() const
         DL_INFER_LOG_INFO_RAW("[%ld] ", shape[j]);
     }
 
-    DL_INFER_LOG_INFO_RAW("\n\n");
+    DL_INFER_LOG_INFO_RAW("\n");
+
+    if (!strides.empty())
+    {
+        DL_INFER_LOG_INFO("    Strides       = ");
+
+        for (int32_t j = 0; j < dim; j++)
+        {
+            DL_INFER_LOG_INFO_RAW("[%ld] ", strides[j]);
+        }
+
+        DL_INFER_LOG_INFO_RAW("\n");
+    }
+
+    if (isQuantized())
+    {
+        DL_INFER_LOG_INFO("    Quant Params  = ");
+
+        for (size_t j = 0; j < quant.scale.size(); j++)
+        {
+            DL_INFER_LOG_INFO_RAW("[%f, %d] ", quant.scale[j], quant.zeroPoint[j]);
+        }
+
+        DL_INFER_LOG_INFO_RAW("\n");
+
+        if (quant.scale.size() > 1)
+        {
+            DL_INFER_LOG_INFO("    Quant Axis    = %d\n", quant.axis);
+        }
+    }
+
+    DL_INFER_LOG_INFO_RAW("\n");
+}
+
+bool DlTensor::isQuantized() const
+{
+    return !quant.scale.empty();
+}
+
+bool DlTensor::isContiguous() const
+{
+    int64_t expected = 1;
+
+    if (strides.empty())
+    {
+        return true;
+    }
+
+    for (int32_t d = dim - 1; d >= 0; d--)
+    {
+        if ((shape[d] != 1) && (strides[d] != expected))
+        {
+            return false;
+        }
+
+        expected *= shape[d];
+    }
+
+    return true;
+}
+
+/* Copy dimensions [d, last] one entry at a time and the dimensions after
+ * 'last', which are contiguous, as a block of 'block' bytes.
+ */
+static void packDims(const DlTensor    &t,
+                     const uint8_t     *src,
+                     uint8_t          *&dst,
+                     int32_t            d,
+                     int32_t            last,
+                     int64_t            block)
+{
+    if (d > last)
+    {
+        memcpy(dst, src, block);
+        dst += block;
+        return;
+    }
+
+    for (int64_t i = 0; i < t.shape[d]; i++)
+    {
+        packDims(t, src + i * t.strides[d] * t.elemSize, dst, d + 1, last, block);
+    }
+}
+
+void DlTensor::packTo(void *dst) const
+{
+    uint8_t    *out = reinterpret_cast<uint8_t *>(dst);
+    int64_t     block = 1;
+    int32_t     last = dim - 1;
+
+    if (isContiguous())
+    {
+        memcpy(dst, data, size);
+        return;
+    }
+
+    /* Find the innermost dimensions that are contiguous. */
+    while ((last >= 0) && (strides[last] == block))
+    {
+        block *= shape[last];
+        last--;
+    }
+
+    packDims(*this, reinterpret_cast<const uint8_t *>(data), out, 0, last,
+             block * elemSize);
 }
 
-DlTensor &DlTensor::operator=(const DlTensor& rhs)
+DlTensor &DlTensor::operator=(DlTensor&& rhs) noexcept
 {
     if (this != &rhs)
     {
@@ -196,8 +473,14 @@ DlTensor &DlTensor::operator=(const DlTensor& rhs)
         elemSize = rhs.elemSize;
         numElem  = rhs.numElem;
         dim      = rhs.dim;
-        shape    = rhs.shape;
-        data     = nullptr;
+        shape    = std::move(rhs.shape);
+        strides  = std::move(rhs.strides);
+        layout   = rhs.layout;
+        quant    = std::move(rhs.quant);
+        data     = rhs.data;
+        buffer   = std::move(rhs.buffer);
+        capacity = rhs.capacity;
+        rhs.data = nullptr;
     }
 
     return *this;
@@ -206,15 +489,50 @@ DlTensor &DlTensor::operator=(const DlTensor& rhs)
 DlTensor::~DlTensor()
 {
     DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
+}
 
-    /* The allocation is based on the size in bytes andof type
-     * uint8_t * to be generic. Given this, the following should
-     * be safe to do so.
-     */
-    if (dataAllocated)
+DlTensorView::DlTensorView(const DlTensor &tensor):
+    name(tensor.name),
+    type(tensor.type),
+    size(tensor.size),
+    numElem(tensor.numElem),
+    elemSize(tensor.elemSize),
+    dim(tensor.dim),
+    shape(tensor.shape),
+    strides(tensor.strides),
+    data(tensor.data)
+{
+}
+
+DlTensorView DlTensorView::slice(int64_t begin, int64_t end) const
+{
+    DlTensorView    v(*this);
+    int64_t         itemSize;
+
+    if ((dim == 0) || (begin < 0) || (end <= begin) || (end > shape[0]))
     {
-        delete [] reinterpret_cast<uint8_t*>(data);
+        throw std::out_of_range("DlTensorView::slice() invalid range.");
     }
+
+    itemSize   = size/shape[0];
+    v.shape[0] = end - begin;
+    v.numElem  = (numElem/shape[0]) * v.shape[0];
+    v.size     = itemSize * v.shape[0];
+
+    /* The items are 'strides[0]' elements apart when strided. */
+    if (!strides.empty())
+    {
+        itemSize = strides[0] * elemSize;
+    }
+
+    v.data     = reinterpret_cast<uint8_t *>(data) + begin * itemSize;
+
+    return v;
+}
+
+DlTensorView DlTensorView::item(int64_t index) const
+{
+    return slice(index, index + 1);
 }
 
 DLInferer* DLInferer::makeInferer(const InfererConfig &config)
@@ -222,16 +540,34 @@ DLInferer* DLInferer::makeInferer(const InfererConfig &config)
     DLInferer  *inter = nullptr;
     int32_t     status = 0;
 
-    if (config.modelFile.empty())
+    /* Some runtime worker threads are created by the constructors. The
+     * runs apply the affinity themselves.
+     */
+    DlCpuAffinityScope  affinity(config.cpuTuning.cpuAffinity);
+
+    if ((config.cpuTuning.interOpThreads > 0) &&
+        (!config.cpuTuning.parallelExecution ||
+         (config.rtType != DL_INFER_RTTYPE_ONNX)))
     {
-        DL_INFER_LOG_ERROR("Please specifiy a valid model path.\n");
-        status = -1;
+        DL_INFER_LOG_WARN("The inter-op threads are only used by the ONNX "
+                          "API in the parallel execution mode, ignoring "
+                          "them.\n");
     }
-    else if (config.rtType.empty())
+
+    if (config.rtType.empty())
     {
         DL_INFER_LOG_ERROR("Please specifiy a valid run-time API type.\n");
         status = -1;
     }
+    else if (config.rtType == DL_INFER_RTTYPE_NULL)
+    {
+        inter = new NullInferer(config.nullSpec, config.shareModel);
+    }
+    else if (config.modelFile.empty())
+    {
+        DL_INFER_LOG_ERROR("Please specifiy a valid model path.\n");
+        status = -1;
+    }
 #if defined(USE_TENSORFLOW_RT)
     else if (config.rtType == DL_INFER_RTTYPE_TFLITE)
     {
@@ -242,9 +578,12 @@ DLInferer* DLInferer::makeInferer(const InfererConfig &config)
         }
         else
         {
-            inter = new TFLiteInferer(config.modelFile, 
+            inter = new TFLiteInferer(config.modelFile,
                                       config.artifactsPath,
-                                      config.enableTidl);
+                                      config.enableTidl,
+                                      config.cpuTuning,
+                                      config.shapeCacheSize,
+                                      config.shareModel);
         }
     }
 #endif
@@ -300,7 +639,10 @@ DLInferer* DLInferer::makeInferer(const InfererConfig &config)
         {
             inter = new ORTInferer(config.modelFile,
                                    config.artifactsPath,
-                                   config.enableTidl);
+                                   config.enableTidl,
+                                   config.enableModelCache,
+                                   config.cpuTuning,
+                                   config.shareModel);
         }
     }
 #endif
@@ -309,9 +651,138 @@ DLInferer* DLInferer::makeInferer(const InfererConfig &config)
         DL_INFER_LOG_ERROR("Unsupported RT API.\n");
     }
 
+    if (inter != nullptr)
+    {
+        inter->setAllocator(config.allocator);
+        inter->setCpuAffinity(config.cpuTuning.cpuAffinity);
+    }
+
+    if ((inter != nullptr) && (config.warmupCount > 0))
+    {
+        status = inter->warmup(config.warmupCount,
+                               config.warmupPattern,
+                               config.warmupTolerance);
+
+        if (status < 0)
+        {
+            DL_INFER_LOG_ERROR("Warm-up failed.\n");
+            delete inter;
+            inter = nullptr;
+        }
+    }
+
     return inter;
 }
 
+int32_t DLInferer::loadModels(const std::vector<std::string>  &modelDirs,
+                              bool                             enableTidl,
+                              std::vector<DLInferer *>        &inferers,
+                              int32_t                          maxThreads,
+                              std::vector<float>              *loadTimes)
+{
+    std::vector<float>          times(modelDirs.size(), 0);
+    std::vector<std::thread>    workers;
+    std::atomic<uint32_t>       next{0};
+    std::atomic<bool>           failed{false};
+    int32_t                     numThreads;
+
+    inferers.assign(modelDirs.size(), nullptr);
+
+    if (maxThreads <= 0)
+    {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    numThreads = std::min<int32_t>(maxThreads, modelDirs.size());
+
+    auto worker = [&]()
+    {
+        uint32_t i;
+
+        while (!failed && ((i = next++) < modelDirs.size()))
+        {
+            auto            start = std::chrono::steady_clock::now();
+            InfererConfig   config;
+
+            try
+            {
+                if (config.getConfig(modelDirs[i], enableTidl) == 0)
+                {
+                    inferers[i] = makeInferer(config);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                DL_INFER_LOG_ERROR("[%s]: %s\n", modelDirs[i].c_str(), e.what());
+            }
+
+            times[i] = std::chrono::duration<float, std::milli>(
+                          std::chrono::steady_clock::now() - start).count();
+
+            if (inferers[i] == nullptr)
+            {
+                DL_INFER_LOG_ERROR("Loading [%s] failed.\n", modelDirs[i].c_str());
+                failed = true;
+            }
+            else
+            {
+                DL_INFER_LOG_INFO("Loaded [%s] in %.2f ms\n",
+                                  modelDirs[i].c_str(), times[i]);
+            }
+        }
+    };
+
+    for (int32_t i = 0; i < numThreads; i++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+
+    if (loadTimes != nullptr)
+    {
+        *loadTimes = times;
+    }
+
+    if (failed)
+    {
+        for (auto *p : inferers)
+        {
+            delete p;
+        }
+
+        inferers.clear();
+        return -1;
+    }
+
+    return 0;
+}
+
+void *DLInferer::allocate(int64_t size)
+{
+    return DlBufferPool::getInstance().allocate(size,
+                                                getBufferAlignment(),
+                                                m_allocator);
+}
+
+void DLInferer::setAllocator(const std::shared_ptr<DlAllocator> &allocator)
+{
+    m_allocator = allocator;
+}
+
+const std::shared_ptr<DlAllocator> &DLInferer::getAllocator() const
+{
+    return m_allocator;
+}
+
+void DLInferer::setCpuAffinity(const std::vector<int32_t> &cores)
+{
+    m_cpuAffinity = cores;
+}
+
 int32_t DLInferer::createBuffers(const VecDlTensor    *ifInfoList,
                                  VecDlTensorPtr       &vecVar,
                                  bool                 allocate)
@@ -321,16 +792,600 @@ int32_t DLInferer::createBuffers(const VecDlTensor    *ifInfoList,
     for (uint64_t i = 0; i < ifInfoList->size(); i++)
     {
         const DlTensor *ifInfo = &ifInfoList->at(i);
-        DlTensor   *obj = new DlTensor(*ifInfo);
+        DlTensor   *obj = new DlTensor(ifInfo->cloneInfo());
 
-        /* Allocate data buffer. */
-        if (allocate)
+        /* Allocate data buffer. The buffers of the tensors whose shape is
+         * not known yet get allocated once the shape is set, see reshape().
+         */
+        if (allocate && (obj->size > 0))
             obj->allocateDataBuffer(*this);
 
         vecVar.push_back(obj);
+
+        if (allocate && (obj->size > 0) && (obj->data == nullptr))
+        {
+            DL_INFER_LOG_ERROR("Allocation of buffer [%lu] failed.\n", i);
+            return -1;
+        }
     }
 
     return 0;
 }
 
+int32_t DLInferer::runBatch(const std::vector<VecDlTensorPtr>  &inputs,
+                            std::vector<VecDlTensorPtr>        &outputs)
+{
+    int32_t status = 0;
+
+    if (inputs.size() != outputs.size())
+    {
+        DL_INFER_LOG_ERROR("Number of input and output frames does not match.\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; (i < inputs.size()) && (status == 0); i++)
+    {
+        status = run(inputs[i], outputs[i]);
+    }
+
+    return status;
+}
+
+int32_t DLInferer::registerBuffers(const VecDlTensorPtr  &inputs,
+                                   VecDlTensorPtr        &outputs)
+{
+    DL_INFER_GET_EXCL_ACCESS;
+
+    if ((inputs.size() != getInputInfo()->size()) ||
+        (outputs.size() != getOutputInfo()->size()))
+    {
+        DL_INFER_LOG_ERROR("Number of inputs or outputs does not match.\n");
+        return -1;
+    }
+
+    m_registered.inputs  = inputs;
+    m_registered.outputs = outputs;
+
+    return bindBuffers(m_registered.inputs, m_registered.outputs);
+}
+
+int32_t DLInferer::run()
+{
+    if (m_registered.inputs.empty() && m_registered.outputs.empty())
+    {
+        DL_INFER_LOG_ERROR("No buffers registered.\n");
+        return -1;
+    }
+
+    return run(m_registered.inputs, m_registered.outputs);
+}
+
+int32_t DLInferer::bindBuffers(const VecDlTensorPtr &/*inputs*/,
+                               VecDlTensorPtr       &/*outputs*/)
+{
+    return 0;
+}
+
+void *DLInferer::getPackedData(const DlTensor *tensor, DlTensor &staging)
+{
+    if (tensor->isContiguous())
+    {
+        return tensor->data;
+    }
+
+    if (staging.size < tensor->size)
+    {
+        staging.size = tensor->size;
+        staging.allocateDataBuffer(*this);
+    }
+
+    tensor->packTo(staging.data);
+
+    return staging.data;
+}
+
+int32_t DLInferer::checkBatch(const std::vector<VecDlTensorPtr>  &inputs,
+                              const std::vector<VecDlTensorPtr>  &outputs,
+                              uint32_t                            numInputs,
+                              uint32_t                            numOutputs)
+{
+    if (inputs.empty() || (inputs.size() != outputs.size()))
+    {
+        DL_INFER_LOG_ERROR("Invalid number of frames.\n");
+        return -1;
+    }
+
+    for (uint32_t b = 0; b < inputs.size(); b++)
+    {
+        if ((inputs[b].size() != numInputs) ||
+            (outputs[b].size() != numOutputs))
+        {
+            DL_INFER_LOG_ERROR("Frame [%d]: number of inputs or outputs "
+                               "does not match.\n", b);
+            return -1;
+        }
+
+        for (uint32_t i = 0; i < numInputs; i++)
+        {
+            if ((inputs[b][i]->data == nullptr) || (inputs[b][i]->size <= 0))
+            {
+                DL_INFER_LOG_ERROR("Frame [%d]: input [%d] has no data.\n",
+                                   b, i);
+                return -1;
+            }
+
+            if (inputs[b][i]->size != inputs[0][i]->size)
+            {
+                DL_INFER_LOG_ERROR("Frame [%d]: size of input [%d] does not "
+                                   "match.\n", b, i);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int32_t DLInferer::packBatch(const std::vector<VecDlTensorPtr> &inputs,
+                             uint32_t                           index,
+                             DlTensor                          &packed)
+{
+    int64_t     frameSize = inputs[0][index]->size;
+    int64_t     batchSize = inputs.size();
+    uint8_t    *dst;
+
+    if (packed.size < (frameSize * batchSize))
+    {
+        packed.size = frameSize * batchSize;
+        packed.allocateDataBuffer(*this);
+    }
+
+    if (packed.data == nullptr)
+    {
+        DL_INFER_LOG_ERROR("Allocation of the batch of input [%d] failed.\n",
+                           index);
+        packed.size = 0;
+        return -1;
+    }
+
+    dst = reinterpret_cast<uint8_t *>(packed.data);
+
+    for (int64_t b = 0; b < batchSize; b++)
+    {
+        inputs[b][index]->packTo(dst + b * frameSize);
+    }
+
+    return 0;
+}
+
+int32_t DLInferer::scatterBatch(const void                    *src,
+                                const std::vector<int64_t>    &shape,
+                                std::vector<VecDlTensorPtr>   &outputs,
+                                uint32_t                       index)
+{
+    const uint8_t          *base = reinterpret_cast<const uint8_t *>(src);
+    int64_t                 batchSize = outputs.size();
+    std::vector<int64_t>    frameShape = shape;
+
+    if (frameShape.empty() || (frameShape[0] != batchSize))
+    {
+        DL_INFER_LOG_ERROR("Output [%d] is not batched along the leading "
+                           "dimension.\n", index);
+        return -1;
+    }
+
+    frameShape[0] = 1;
+
+    for (int64_t b = 0; b < batchSize; b++)
+    {
+        DlTensor   *info = outputs[b][index];
+
+        /* Grows the buffer of the frame if the output got larger. */
+        info->reshape(frameShape, *this);
+
+        if ((info->data == nullptr) || (info->size <= 0))
+        {
+            DL_INFER_LOG_ERROR("Frame [%ld]: output [%d] cannot be "
+                               "allocated.\n", b, index);
+            return -1;
+        }
+
+        memcpy(info->data, base + b * info->size, info->size);
+    }
+
+    return 0;
+}
+
+std::future<int32_t> DLInferer::runAsync(const VecDlTensorPtr &inputs,
+                                         VecDlTensorPtr       &outputs,
+                                         InferCallback         callback)
+{
+    std::future<int32_t>            fut;
+    std::unique_lock<std::mutex>    lock(m_asyncMutex);
+
+    /* Start the worker on the first request. */
+    if (!m_asyncThread.joinable())
+    {
+        m_asyncStop   = false;
+        m_asyncThread = std::thread([this]{asyncWorker();});
+    }
+
+    m_asyncQueue.push_back({&inputs, &outputs, std::move(callback), {}});
+    fut = m_asyncQueue.back().promise.get_future();
+    m_asyncPending++;
+
+    lock.unlock();
+    m_asyncCv.notify_one();
+
+    return fut;
+}
+
+void DLInferer::asyncWorker()
+{
+    while (true)
+    {
+        AsyncRequest                    req;
+        std::unique_lock<std::mutex>    lock(m_asyncMutex);
+        int32_t                         status;
+
+        m_asyncCv.wait(lock, [this]{
+            return m_asyncStop || !m_asyncQueue.empty();
+        });
+
+        /* Drain the queue before honoring the stop request. */
+        if (m_asyncQueue.empty())
+        {
+            break;
+        }
+
+        req = std::move(m_asyncQueue.front());
+        m_asyncQueue.pop_front();
+        lock.unlock();
+
+        try
+        {
+            status = run(*req.inputs, *req.outputs);
+        }
+        catch (const std::exception &e)
+        {
+            DL_INFER_LOG_ERROR("Asynchronous run failed [%s].\n", e.what());
+            status = -1;
+        }
+        catch (...)
+        {
+            DL_INFER_LOG_ERROR("Asynchronous run failed.\n");
+            status = -1;
+        }
+
+        /* A throwing callback must neither end the worker nor leave the
+         * request pending.
+         */
+        if (req.callback)
+        {
+            try
+            {
+                req.callback(status, *req.inputs, *req.outputs);
+            }
+            catch (const std::exception &e)
+            {
+                DL_INFER_LOG_ERROR("Completion callback failed [%s].\n",
+                                   e.what());
+            }
+            catch (...)
+            {
+                DL_INFER_LOG_ERROR("Completion callback failed.\n");
+            }
+        }
+
+        req.promise.set_value(status);
+
+        lock.lock();
+        m_asyncPending--;
+        lock.unlock();
+        m_asyncDoneCv.notify_all();
+    }
+}
+
+void DLInferer::waitAsync()
+{
+    std::unique_lock<std::mutex>    lock(m_asyncMutex);
+
+    m_asyncDoneCv.wait(lock, [this]{return m_asyncPending == 0;});
+}
+
+void DLInferer::stopAsync()
+{
+    {
+        std::unique_lock<std::mutex>    lock(m_asyncMutex);
+
+        if (!m_asyncThread.joinable())
+        {
+            return;
+        }
+
+        m_asyncStop = true;
+    }
+
+    m_asyncCv.notify_one();
+    m_asyncThread.join();
+}
+
+int32_t DLInferer::createBufferRing(int32_t depth)
+{
+    const VecDlTensor  *inInfo  = getInputInfo();
+    const VecDlTensor  *outInfo = getOutputInfo();
+    int32_t             status = 0;
+
+    if (depth <= 0)
+    {
+        DL_INFER_LOG_ERROR("Invalid buffer ring depth [%d].\n", depth);
+        return -1;
+    }
+
+    std::unique_lock<std::mutex>    lock(m_ringMutex);
+
+    /* Requests may still be reading or writing the sets that are out. */
+    if (m_freeSets.size() != m_bufferRing.size())
+    {
+        DL_INFER_LOG_ERROR("Buffer sets of the ring are still in use.\n");
+        return -1;
+    }
+
+    deleteBufferRing();
+    m_bufferRing.resize(depth);
+
+    for (auto &set : m_bufferRing)
+    {
+        status = createBuffers(inInfo, set.inputs, true);
+
+        if (status == 0)
+        {
+            status = createBuffers(outInfo, set.outputs, true);
+        }
+
+        if (status < 0)
+        {
+            DL_INFER_LOG_ERROR("createBuffers() failed.\n");
+            break;
+        }
+
+        m_freeSets.push_back(&set);
+    }
+
+    /* A partial ring would leave acquireBufferSet() waiting on sets that
+     * do not exist.
+     */
+    if (status < 0)
+    {
+        deleteBufferRing();
+    }
+
+    return status;
+}
+
+void DLInferer::deleteBufferRing()
+{
+    for (auto &set : m_bufferRing)
+    {
+        for (auto *t : set.inputs)  delete t;
+        for (auto *t : set.outputs) delete t;
+    }
+
+    m_freeSets.clear();
+    m_bufferRing.clear();
+}
+
+DlBufferSet *DLInferer::acquireBufferSet()
+{
+    std::unique_lock<std::mutex>    lock(m_ringMutex);
+    DlBufferSet                    *set;
+
+    if (m_bufferRing.empty())
+    {
+        DL_INFER_LOG_ERROR("Buffer ring not created.\n");
+        return nullptr;
+    }
+
+    m_ringCv.wait(lock, [this]{return !m_freeSets.empty();});
+
+    set = m_freeSets.back();
+    m_freeSets.pop_back();
+
+    return set;
+}
+
+int32_t DLInferer::releaseBufferSet(DlBufferSet *set)
+{
+    {
+        std::unique_lock<std::mutex>    lock(m_ringMutex);
+        bool                            inRing;
+        bool                            isFree;
+
+        inRing = std::any_of(m_bufferRing.begin(), m_bufferRing.end(),
+                             [set](const DlBufferSet &s){return &s == set;});
+
+        isFree = std::find(m_freeSets.begin(), m_freeSets.end(), set) !=
+                 m_freeSets.end();
+
+        if (!inRing || isFree)
+        {
+            DL_INFER_LOG_ERROR("Buffer set is not an acquired set of the "
+                               "ring.\n");
+            return -1;
+        }
+
+        m_freeSets.push_back(set);
+    }
+
+    m_ringCv.notify_one();
+
+    return 0;
+}
+
+int32_t DLInferer::warmup(int32_t              maxRuns,
+                          const std::string   &pattern,
+                          float                tolerance,
+                          std::vector<float>  *latencies)
+{
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    std::mt19937    rng;
+    float           prevMs = 0;
+    int32_t         status;
+
+    m_ready = false;
+
+    status = createBuffers(getInputInfo(), inputs, true);
+
+    if (status == 0)
+    {
+        status = createBuffers(getOutputInfo(), outputs, true);
+    }
+
+    /* The inputs of an unknown shape have no buffer yet. A dynamic batch
+     * dimension is resolved to a single frame, while the other dynamic
+     * dimensions have no safe default and the warm-up is skipped.
+     */
+    for (auto *t : inputs)
+    {
+        std::vector<int64_t>    shape = t->shape;
+
+        if ((status < 0) || (t->size > 0))
+        {
+            continue;
+        }
+
+        if (!shape.empty() && (shape[0] < 0))
+        {
+            shape[0] = 1;
+        }
+
+        if (shape.empty() ||
+            std::any_of(shape.begin(), shape.end(),
+                        [](int64_t d){ return d < 0; }))
+        {
+            DL_INFER_LOG_INFO("Input [%s] has a dynamic shape, skipping the "
+                              "warm-up.\n", t->name ? t->name : "");
+            maxRuns = 0;
+            break;
+        }
+
+        t->reshape(shape, *this);
+
+        if (t->data == nullptr)
+        {
+            status = -1;
+        }
+    }
+
+    for (auto *t : inputs)
+    {
+        if (maxRuns <= 0)
+        {
+            break;
+        }
+
+        if (pattern == "random")
+        {
+            /* Keep the values finite whatever the type is. */
+            if (t->type == DlInferType_Float32)
+            {
+                std::uniform_real_distribution<float>   dist(0.0f, 1.0f);
+                float                                  *p = reinterpret_cast<float *>(t->data);
+
+                for (int64_t i = 0; i < t->numElem; i++)
+                {
+                    p[i] = dist(rng);
+                }
+            }
+            else
+            {
+                std::uniform_int_distribution<int32_t>  dist(0, 63);
+                uint8_t                                *p = reinterpret_cast<uint8_t *>(t->data);
+
+                for (int64_t i = 0; i < t->size; i++)
+                {
+                    p[i] = dist(rng);
+                }
+            }
+        }
+        else
+        {
+            memset(t->data, 0, t->size);
+        }
+    }
+
+    for (int32_t i = 0; (status == 0) && (i < maxRuns); i++)
+    {
+        auto    start = std::chrono::steady_clock::now();
+        float   ms;
+
+        status = run(inputs, outputs);
+
+        ms = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+
+        DL_INFER_LOG_INFO("Warm-up run [%d] took %.3f ms\n", i, ms);
+
+        if (latencies != nullptr)
+        {
+            latencies->push_back(ms);
+        }
+
+        /* Stop once the run time has settled. */
+        if ((i > 0) && (std::abs(ms - prevMs) <= (tolerance * prevMs)))
+        {
+            break;
+        }
+
+        prevMs = ms;
+    }
+
+    for (auto *t : inputs)
+    {
+        delete t;
+    }
+
+    for (auto *t : outputs)
+    {
+        delete t;
+    }
+
+    /* Keep the statistics to the steady state runs. */
+    m_runStats.reset();
+
+    m_ready = status == 0;
+
+    return status;
+}
+
+bool DLInferer::isReady() const
+{
+    return m_ready;
+}
+
+DlLatencyStats DLInferer::getStats(bool reset)
+{
+    DlLatencyStats  stats = m_runStats.getStats();
+
+    if (reset)
+    {
+        m_runStats.reset();
+    }
+
+    return stats;
+}
+
+DLInferer::~DLInferer()
+{
+    /* The concrete classes are expected to have stopped the worker already
+     * since it calls into the virtual run().
+     */
+    stopAsync();
+
+    std::unique_lock<std::mutex>    lock(m_ringMutex);
+
+    deleteBufferRing();
+}
+
 } // namespace ti::dl_inferer
@@ -0,0 +1,321 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <fstream>
+
+/* Module headers. */
+#include <ti_dl_inferer_allocator.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+#define DL_ALLOCATOR_DEFAULT_HUGE_PAGE_SIZE   (2*1024*1024)
+
+std::shared_ptr<DlAllocator> DlAllocator::makeAllocator(const std::string &name)
+{
+    if (name == "default")
+    {
+        return getDefault();
+    }
+    else if (name == "hugepage")
+    {
+        return std::make_shared<DlHugePageAllocator>();
+    }
+    else if (name == "memfd")
+    {
+        return std::make_shared<DlMemfdAllocator>();
+    }
+
+    DL_INFER_LOG_ERROR("Unknown allocator [%s].\n", name.c_str());
+    return nullptr;
+}
+
+const std::shared_ptr<DlAllocator> &DlAllocator::getDefault()
+{
+    /* Never destroyed, like the pool caching its buffers. */
+    static auto    *allocator =
+        new std::shared_ptr<DlAllocator>(std::make_shared<DlHeapAllocator>());
+
+    return *allocator;
+}
+
+void *DlHeapAllocator::allocate(int64_t size, int32_t alignment)
+{
+    return aligned_alloc(alignment, size);
+}
+
+void DlHeapAllocator::free(void *ptr, int64_t /*size*/)
+{
+    ::free(ptr);
+}
+
+int32_t DlHeapAllocator::getAlignment() const
+{
+    return alignof(max_align_t);
+}
+
+const char *DlHeapAllocator::getName() const
+{
+    return "default";
+}
+
+DlHugePageAllocator::DlHugePageAllocator():
+    m_pageSize(DL_ALLOCATOR_DEFAULT_HUGE_PAGE_SIZE)
+{
+    std::ifstream   meminfo("/proc/meminfo");
+    std::string     key;
+
+    /* The line reads "Hugepagesize:    2048 kB". */
+    while (meminfo >> key)
+    {
+        if (key == "Hugepagesize:")
+        {
+            int64_t sizeKb;
+
+            if (meminfo >> sizeKb)
+            {
+                m_pageSize = sizeKb * 1024;
+            }
+
+            break;
+        }
+    }
+}
+
+int64_t DlHugePageAllocator::getAllocSize(int64_t size) const
+{
+    return ((size + m_pageSize - 1) / m_pageSize) * m_pageSize;
+}
+
+void *DlHugePageAllocator::allocate(int64_t size, int32_t alignment)
+{
+    int64_t     len = getAllocSize(size);
+    void       *ptr = MAP_FAILED;
+
+    if (alignment > m_pageSize)
+    {
+        DL_INFER_LOG_ERROR("Alignment %d exceeds the huge page size.\n",
+                           alignment);
+        return nullptr;
+    }
+
+    if (!m_noExplicit)
+    {
+        ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (ptr == MAP_FAILED)
+        {
+            DL_INFER_LOG_INFO("No explicit huge pages available, using "
+                              "transparent huge pages.\n");
+            m_noExplicit = true;
+        }
+    }
+
+    if (ptr == MAP_FAILED)
+    {
+        uint8_t    *raw;
+        uint8_t    *start;
+        int64_t     head;
+
+        /* Map one more huge page so that the start can be aligned to a huge
+         * page boundary, which transparent huge pages need.
+         */
+        raw = static_cast<uint8_t *>(mmap(nullptr, len + m_pageSize,
+                                          PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS,
+                                          -1, 0));
+
+        if (raw == MAP_FAILED)
+        {
+            DL_INFER_LOG_ERROR("Mapping of %ld bytes failed.\n", len);
+            return nullptr;
+        }
+
+        head  = (m_pageSize - reinterpret_cast<uintptr_t>(raw) % m_pageSize) %
+                m_pageSize;
+        start = raw + head;
+
+        if (head > 0)
+        {
+            munmap(raw, head);
+        }
+
+        if (head < m_pageSize)
+        {
+            munmap(start + len, m_pageSize - head);
+        }
+
+        if (madvise(start, len, MADV_HUGEPAGE) < 0)
+        {
+            DL_INFER_LOG_DEBUG("madvise(MADV_HUGEPAGE) failed.\n");
+        }
+
+        ptr = start;
+    }
+
+    return ptr;
+}
+
+void DlHugePageAllocator::free(void *ptr, int64_t size)
+{
+    munmap(ptr, getAllocSize(size));
+}
+
+int32_t DlHugePageAllocator::getAlignment() const
+{
+    return m_pageSize;
+}
+
+const char *DlHugePageAllocator::getName() const
+{
+    return "hugepage";
+}
+
+void *DlMemfdAllocator::allocate(int64_t size, int32_t alignment)
+{
+    int32_t     fd;
+    void       *ptr;
+
+    if (alignment > getAlignment())
+    {
+        DL_INFER_LOG_ERROR("Alignment %d exceeds the page size.\n", alignment);
+        return nullptr;
+    }
+
+    fd = memfd_create("dl_tensor", MFD_CLOEXEC);
+
+    if (fd < 0)
+    {
+        DL_INFER_LOG_ERROR("memfd_create() failed.\n");
+        return nullptr;
+    }
+
+    if (ftruncate(fd, size) < 0)
+    {
+        DL_INFER_LOG_ERROR("Sizing the memory file to %ld bytes failed.\n",
+                           size);
+        close(fd);
+        return nullptr;
+    }
+
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (ptr == MAP_FAILED)
+    {
+        DL_INFER_LOG_ERROR("Mapping of %ld bytes failed.\n", size);
+        close(fd);
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    m_fds[ptr] = fd;
+
+    return ptr;
+}
+
+void DlMemfdAllocator::free(void *ptr, int64_t size)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    auto                            it = m_fds.find(ptr);
+
+    munmap(ptr, size);
+
+    if (it != m_fds.end())
+    {
+        close(it->second);
+        m_fds.erase(it);
+    }
+}
+
+int32_t DlMemfdAllocator::getAlignment() const
+{
+    return sysconf(_SC_PAGESIZE);
+}
+
+int64_t DlMemfdAllocator::getAllocSize(int64_t size) const
+{
+    int64_t pageSize = getAlignment();
+
+    return ((size + pageSize - 1) / pageSize) * pageSize;
+}
+
+const char *DlMemfdAllocator::getName() const
+{
+    return "memfd";
+}
+
+int32_t DlMemfdAllocator::getFd(const void *ptr)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    auto                            it = m_fds.find(ptr);
+
+    return (it != m_fds.end()) ? it->second : -1;
+}
+
+} // namespace ti::dl_inferer
@@ -0,0 +1,280 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Module headers. */
+#include <ti_dl_inferer_buffer_pool.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+#define DL_BUFFER_POOL_MIN_BUCKET   (256)
+
+DlBufferPool &DlBufferPool::getInstance()
+{
+    /* Never destroyed so that the tensors released during the static
+     * destruction can still be returned to the pool.
+     */
+    static DlBufferPool    *pool = new DlBufferPool();
+
+    return *pool;
+}
+
+int64_t DlBufferPool::getBucketSize(int64_t size, int32_t alignment)
+{
+    int64_t bucket = DL_BUFFER_POOL_MIN_BUCKET;
+
+    if (size > bucket)
+    {
+        int64_t pow2 = bucket;
+        int64_t step;
+
+        while ((pow2 << 1) < size)
+        {
+            pow2 <<= 1;
+        }
+
+        step   = pow2 / 4;
+        bucket = ((size + step - 1) / step) * step;
+    }
+
+    /* aligned_alloc() requires the size to be a multiple of the alignment. */
+    return ((bucket + alignment - 1) / alignment) * alignment;
+}
+
+void *DlBufferPool::allocate(int64_t                             size,
+                             int32_t                             alignment,
+                             const std::shared_ptr<DlAllocator> &allocator)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    DlAllocator                    *alloc;
+    Key                             key;
+    int64_t                         bucket;
+    void                           *ptr = nullptr;
+
+    if (size <= 0)
+    {
+        return nullptr;
+    }
+
+    if ((alignment < (int32_t)sizeof(void *)) ||
+        ((alignment & (alignment - 1)) != 0))
+    {
+        alignment = sizeof(void *);
+    }
+
+    alloc = allocator ? allocator.get() : DlAllocator::getDefault().get();
+
+    /* Account for the memory the allocator actually takes. */
+    bucket = alloc->getAllocSize(getBucketSize(size, alignment));
+    key    = {bucket, alignment, alloc};
+
+    auto it = m_freeLists.find(key);
+
+    if ((it != m_freeLists.end()) && !it->second.empty())
+    {
+        ptr = it->second.back();
+        it->second.pop_back();
+        m_stats.cachedBytes -= bucket;
+        m_stats.hits++;
+    }
+    else
+    {
+        ptr = alloc->allocate(bucket, alignment);
+
+        if (ptr == nullptr)
+        {
+            /* Give the cached memory back to the system and retry. */
+            freeCached();
+
+            ptr = alloc->allocate(bucket, alignment);
+        }
+
+        if (ptr == nullptr)
+        {
+            DL_INFER_LOG_ERROR("Allocation of %ld bytes failed.\n", bucket);
+            return nullptr;
+        }
+
+        auto &entry = m_allocators[alloc];
+
+        if (entry.allocator == nullptr)
+        {
+            entry.allocator = allocator ? allocator : DlAllocator::getDefault();
+        }
+
+        entry.numBuffers++;
+        m_stats.misses++;
+    }
+
+    m_inUse[ptr] = key;
+    m_stats.numInUse++;
+    m_stats.inUseBytes += bucket;
+
+    return ptr;
+}
+
+void DlBufferPool::release(void *ptr)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    auto it = m_inUse.find(ptr);
+
+    if (it == m_inUse.end())
+    {
+        DL_INFER_LOG_ERROR("Buffer %p was not allocated by the pool.\n", ptr);
+        return;
+    }
+
+    Key     key = it->second;
+    int64_t bucket = std::get<0>(key);
+
+    m_inUse.erase(it);
+    m_stats.numInUse--;
+    m_stats.inUseBytes -= bucket;
+
+    if (m_stats.cachedBytes + bucket > m_maxCachedBytes)
+    {
+        freeBuffer(ptr, key);
+    }
+    else
+    {
+        m_freeLists[key].push_back(ptr);
+        m_stats.cachedBytes += bucket;
+    }
+}
+
+void DlBufferPool::freeBuffer(void *ptr, const Key &key)
+{
+    DlAllocator    *alloc = std::get<2>(key);
+    auto            it = m_allocators.find(alloc);
+
+    alloc->free(ptr, std::get<0>(key));
+
+    if ((it != m_allocators.end()) && (--it->second.numBuffers == 0))
+    {
+        m_allocators.erase(it);
+    }
+}
+
+void DlBufferPool::freeCached()
+{
+    for (auto &[key, list] : m_freeLists)
+    {
+        for (auto *p : list)
+        {
+            freeBuffer(p, key);
+        }
+    }
+
+    m_freeLists.clear();
+    m_stats.cachedBytes = 0;
+}
+
+void DlBufferPool::trim()
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    freeCached();
+}
+
+void DlBufferPool::setMaxCachedBytes(int64_t maxBytes)
+{
+    {
+        std::unique_lock<std::mutex>    lock(m_mutex);
+
+        m_maxCachedBytes = maxBytes;
+
+        if (m_stats.cachedBytes <= m_maxCachedBytes)
+        {
+            return;
+        }
+    }
+
+    trim();
+}
+
+DlBufferPoolStats DlBufferPool::getStats()
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    return m_stats;
+}
+
+void DlBufferPool::dumpInfo()
+{
+    const DlBufferPoolStats &stats = getStats();
+
+    DL_INFER_LOG_INFO("DlBufferPool::Hits             = %lu\n", stats.hits);
+    DL_INFER_LOG_INFO("DlBufferPool::Misses           = %lu\n", stats.misses);
+    DL_INFER_LOG_INFO("DlBufferPool::Buffers In Use   = %lu\n", stats.numInUse);
+    DL_INFER_LOG_INFO("DlBufferPool::Bytes In Use     = %ld\n", stats.inUseBytes);
+    DL_INFER_LOG_INFO("DlBufferPool::Bytes Cached     = %ld\n", stats.cachedBytes);
+    DL_INFER_LOG_INFO_RAW("\n");
+}
+
+} // namespace ti::dl_inferer
@@ -62,11 +62,13 @@
 /* Standard headers. */
 #include <string>
 #include <filesystem>
+#include <algorithm>
 
 /* Third-party headers. */
 #include <yaml-cpp/yaml.h>
 
 /* Module headers. */
+#include <ti_dl_inferer.h>
 #include <ti_dl_inferer_config.h>
 #include <ti_dl_inferer_logger.h>
 
@@ -76,12 +78,269 @@ using namespace ti::dl_inferer::utils;
 namespace ti::dl_inferer
 {
 
+static void parseNullTensors(const YAML::Node             &n,
+                             std::vector<NullTensorSpec>  &specs)
+{
+    specs.clear();
+
+    for (const auto &t : n)
+    {
+        NullTensorSpec  spec;
+
+        if (t["name"])
+        {
+            spec.name = t["name"].as<string>();
+        }
+
+        if (t["type"])
+        {
+            spec.type = t["type"].as<string>();
+        }
+
+        spec.shape = t["shape"].as<std::vector<int64_t>>();
+
+        /* Quantized tensors, with either a single or a list of values. */
+        if (t["scale"])
+        {
+            const YAML::Node   &scale = t["scale"];
+            const YAML::Node   &zeroPoint = t["zero_point"];
+
+            if (scale.IsSequence())
+            {
+                spec.scale = scale.as<std::vector<float>>();
+            }
+            else
+            {
+                spec.scale.push_back(scale.as<float>());
+            }
+
+            if (zeroPoint && zeroPoint.IsSequence())
+            {
+                spec.zeroPoint = zeroPoint.as<std::vector<int32_t>>();
+            }
+            else
+            {
+                spec.zeroPoint.push_back(zeroPoint ? zeroPoint.as<int32_t>() : 0);
+            }
+
+            spec.zeroPoint.resize(spec.scale.size(), spec.zeroPoint[0]);
+        }
+
+        if (t["quant_axis"])
+        {
+            spec.quantAxis = t["quant_axis"].as<int32_t>();
+        }
+
+        specs.push_back(spec);
+    }
+}
+
+/* Derive the synthetic inferer configuration from the model parameters and
+ * apply the explicit 'null_inferer' settings on top, if any.
+ */
+static void getNullSpec(const YAML::Node   &config,
+                        NullInfererSpec    &spec)
+{
+    const YAML::Node   &preProc = config["preprocess"];
+    const YAML::Node   &postProc = config["postprocess"];
+    const YAML::Node   &session = config["session"];
+    const YAML::Node   &metric = config["metric"];
+    const YAML::Node   &n = config["null_inferer"];
+    NullTensorSpec      input{"input"};
+    NullTensorSpec      output{"output"};
+    string              taskType;
+    string              layout{"NCHW"};
+    int64_t             height = 224;
+    int64_t             width = 224;
+
+    if (config["task_type"])
+    {
+        taskType = config["task_type"].as<string>();
+    }
+
+    if (preProc && preProc["crop"])
+    {
+        const YAML::Node &cropNode = preProc["crop"];
+
+        if (cropNode.Type() == YAML::NodeType::Sequence)
+        {
+            height = cropNode[0].as<int64_t>();
+            width  = cropNode[1].as<int64_t>();
+        }
+        else if (cropNode.Type() == YAML::NodeType::Scalar)
+        {
+            height = cropNode.as<int64_t>();
+            width  = height;
+        }
+    }
+
+    if (preProc && preProc["data_layout"])
+    {
+        layout = preProc["data_layout"].as<string>();
+    }
+
+    /* The mean and scale get folded into the model with input optimization
+     * and the model then takes the pixels as is.
+     */
+    if (session && session["input_optimization"] &&
+        session["input_optimization"].as<bool>())
+    {
+        input.type = "uint8";
+    }
+
+    if (layout == "NHWC")
+    {
+        input.shape = {1, height, width, 3};
+    }
+    else
+    {
+        input.shape = {1, 3, height, width};
+    }
+
+    if (taskType == "classification")
+    {
+        spec.fill       = "logits";
+        spec.numClasses = 1000;
+        output.shape    = {1, spec.numClasses};
+    }
+    else if (taskType == "detection")
+    {
+        int32_t rowSize = 6;
+
+        spec.fill = "detection";
+
+        /* Only labels with an offset defined can be mapped to a class. */
+        if (metric && metric["label_offset_pred"] &&
+            (metric["label_offset_pred"].Type() == YAML::NodeType::Map))
+        {
+            for (const auto &it : metric["label_offset_pred"])
+            {
+                spec.labels.push_back(it.first.as<int32_t>());
+            }
+        }
+        else
+        {
+            spec.labels = {0};
+        }
+
+        if (postProc && postProc["formatter"] &&
+            postProc["formatter"]["src_indices"])
+        {
+            const YAML::Node &f = postProc["formatter"]["src_indices"];
+
+            if (f.size() == 2)
+            {
+                spec.formatter[4] = f[0].as<int32_t>();
+                spec.formatter[5] = f[1].as<int32_t>();
+            }
+            else if ((f.size() == 6) || (f.size() == 4))
+            {
+                for (uint8_t i = 0; i < f.size(); i++)
+                {
+                    spec.formatter[i] = f[i].as<int32_t>();
+                }
+            }
+        }
+
+        if (postProc && postProc["normalized_detections"])
+        {
+            spec.normDetect = postProc["normalized_detections"].as<bool>();
+        }
+
+        for (const auto pos : spec.formatter)
+        {
+            rowSize = std::max(rowSize, pos + 1);
+        }
+
+        output.shape = {1, 20, rowSize};
+    }
+    else if (taskType == "segmentation")
+    {
+        spec.fill       = "classmap";
+        spec.numClasses = 21;
+        output.type     = "uint8";
+        output.shape    = {1, 1, height, width};
+    }
+    else
+    {
+        output.shape = {1, 1};
+    }
+
+    spec.inputs  = {input};
+    spec.outputs = {output};
+
+    if (!n)
+    {
+        return;
+    }
+
+    if (n["inputs"])
+    {
+        parseNullTensors(n["inputs"], spec.inputs);
+    }
+
+    if (n["outputs"])
+    {
+        parseNullTensors(n["outputs"], spec.outputs);
+    }
+
+    if (n["latency_ms"])
+    {
+        spec.latencyMs = n["latency_ms"].as<float>();
+    }
+
+    if (n["jitter_ms"])
+    {
+        spec.jitterMs = n["jitter_ms"].as<float>();
+    }
+
+    if (n["fill"])
+    {
+        spec.fill = n["fill"].as<string>();
+    }
+
+    if (n["num_classes"])
+    {
+        spec.numClasses = n["num_classes"].as<int32_t>();
+    }
+
+    if (n["labels"])
+    {
+        spec.labels = n["labels"].as<std::vector<int32_t>>();
+    }
+
+    if (n["seed"])
+    {
+        spec.seed = n["seed"].as<uint32_t>();
+    }
+
+    if (n["weights_mb"])
+    {
+        spec.weightsBytes = n["weights_mb"].as<double>() * 1024 * 1024;
+    }
+
+    if (n["concurrent"])
+    {
+        spec.concurrent = n["concurrent"].as<bool>();
+    }
+}
+
 void InfererConfig::dumpInfo()
 {
     DL_INFER_LOG_INFO("InfererConfig::Model Path        = %s\n", modelFile.c_str());
     DL_INFER_LOG_INFO("InfererConfig::Artifacts Path    = %s\n", artifactsPath.c_str());
     DL_INFER_LOG_INFO("InfererConfig::Runtime API       = %s\n", rtType.c_str());
     DL_INFER_LOG_INFO("InfererConfig::Device Type       = %s\n", devType.c_str());
+    DL_INFER_LOG_INFO("InfererConfig::Num Instances     = %d\n", numInstances);
+    DL_INFER_LOG_INFO("InfererConfig::Share Model       = %d\n", shareModel);
+    DL_INFER_LOG_INFO("InfererConfig::Allocator         = %s\n",
+                      allocator ? allocator->getName() : "default");
+    DL_INFER_LOG_INFO("InfererConfig::Warm-up Count     = %d\n", warmupCount);
+    DL_INFER_LOG_INFO("InfererConfig::Warm-up Pattern   = %s\n", warmupPattern.c_str());
+    DL_INFER_LOG_INFO("InfererConfig::Intra-op Threads  = %d\n", cpuTuning.intraOpThreads);
+    DL_INFER_LOG_INFO("InfererConfig::Inter-op Threads  = %d\n", cpuTuning.interOpThreads);
+    DL_INFER_LOG_INFO("InfererConfig::Execution Mode    = %s\n",
+                      cpuTuning.parallelExecution ? "parallel" : "sequential");
     DL_INFER_LOG_INFO_RAW("\n");
 }
 
@@ -101,8 +360,13 @@ int32_t InfererConfig::getConfig(const std::string  &modelBasePath,
 
     const YAML::Node    config = YAML::LoadFile(paramFile.c_str());;
     const YAML::Node    &n = config["session"];
+    bool                nullRt;
     enableTidl = enableTidlDelegate;
 
+    /* The synthetic inferer does not need a model. */
+    nullRt = n && n["session_name"] &&
+             (n["session_name"].as<string>() == DL_INFER_RTTYPE_NULL);
+
     /** Validate the parsed yaml configuration and create the configuration
     * for the inference object creation.
     */
@@ -111,12 +375,12 @@ int32_t InfererConfig::getConfig(const std::string  &modelBasePath,
         DL_INFER_LOG_ERROR("Inference configuration parameters  missing.\n");
         status = -1;
     }
-    else if (!n["model_path"])
+    else if (!n["model_path"] && !nullRt)
     {
         DL_INFER_LOG_ERROR("Please specifiy a valid model path.\n");
         status = -1;
     }
-    else if (!n["artifacts_folder"])
+    else if (!n["artifacts_folder"] && !nullRt)
     {
         DL_INFER_LOG_ERROR("Artifacts directory path missing.\n");
         status = -1;
@@ -141,7 +405,6 @@ int32_t InfererConfig::getConfig(const std::string  &modelBasePath,
             modelFile = modelBasePath + "/" + modSrc;
         }
 
-        const string &artSrc = n["artifacts_folder"].as<string>();
         artifactsPath = modelBasePath + "/artifacts";
 
         if (n["device_type"])
@@ -166,6 +429,74 @@ int32_t InfererConfig::getConfig(const std::string  &modelBasePath,
         {
             dataLayout = n["input_data_layout"].as<std::string>();
         }
+
+        if (n["model_cache"])
+        {
+            enableModelCache = n["model_cache"].as<bool>();
+        }
+
+        if (n["share_model"])
+        {
+            shareModel = n["share_model"].as<bool>();
+        }
+
+        if (n["allocator"])
+        {
+            allocator = DlAllocator::makeAllocator(n["allocator"].as<string>());
+
+            if (allocator == nullptr)
+            {
+                status = -1;
+            }
+        }
+
+        if (n["num_instances"])
+        {
+            numInstances = n["num_instances"].as<int32_t>();
+        }
+
+        if (n["warmup_count"])
+        {
+            warmupCount = n["warmup_count"].as<int32_t>();
+        }
+
+        if (n["warmup_pattern"])
+        {
+            warmupPattern = n["warmup_pattern"].as<string>();
+        }
+
+        if (n["warmup_tolerance"])
+        {
+            warmupTolerance = n["warmup_tolerance"].as<float>();
+        }
+
+        if (n["intra_op_threads"])
+        {
+            cpuTuning.intraOpThreads = n["intra_op_threads"].as<int32_t>();
+        }
+
+        if (n["inter_op_threads"])
+        {
+            cpuTuning.interOpThreads = n["inter_op_threads"].as<int32_t>();
+        }
+
+        if (n["execution_mode"])
+        {
+            cpuTuning.parallelExecution =
+                (n["execution_mode"].as<string>() == "parallel");
+        }
+
+        if (n["shape_cache_size"])
+        {
+            shapeCacheSize = n["shape_cache_size"].as<int32_t>();
+        }
+
+        if (n["cpu_affinity"])
+        {
+            cpuTuning.cpuAffinity = n["cpu_affinity"].as<vector<int32_t>>();
+        }
+
+        getNullSpec(config, nullSpec);
     }
 
     return status;
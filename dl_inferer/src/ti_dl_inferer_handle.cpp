@@ -0,0 +1,265 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <chrono>
+#include <stdexcept>
+
+/* Module headers. */
+#include <ti_dl_inferer_handle.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+/* Interval at which the retired inferers are checked for remaining users. */
+#define HANDLE_REAP_INTERVAL_MS     (2)
+
+DlModelHandle::DlModelHandle(const InfererConfig &config):
+    DlModelHandle(DLInferer::makeInferer(config))
+{
+}
+
+DlModelHandle::DlModelHandle(DLInferer *inferer)
+{
+    if (inferer == nullptr)
+    {
+        throw std::runtime_error("DlModelHandle object creation failed.");
+    }
+
+    m_current.reset(inferer);
+    m_worker = std::thread([this]{ worker(); });
+}
+
+std::shared_ptr<DLInferer> DlModelHandle::acquire() const
+{
+    return std::atomic_load(&m_current);
+}
+
+int32_t DlModelHandle::swap(const InfererConfig &config)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_pending)
+    {
+        DL_INFER_LOG_ERROR("A model swap is already in progress.\n");
+        return -1;
+    }
+
+    m_request  = std::make_unique<InfererConfig>(config);
+    m_pending  = true;
+    m_workerCv.notify_one();
+
+    return 0;
+}
+
+bool DlModelHandle::isSwapPending()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_pending;
+}
+
+int32_t DlModelHandle::waitSwap()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_doneCv.wait(lock, [this]{ return !m_pending; });
+
+    return m_swapStatus;
+}
+
+uint64_t DlModelHandle::getGeneration() const
+{
+    return m_generation.load(std::memory_order_acquire);
+}
+
+bool DlModelHandle::isSameSignature(DLInferer &a, DLInferer &b)
+{
+    auto same = [](const VecDlTensor *x, const VecDlTensor *y)
+    {
+        if (x->size() != y->size())
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < x->size(); i++)
+        {
+            const DlTensor &s = x->at(i);
+            const DlTensor &t = y->at(i);
+
+            if ((s.type != t.type) ||
+                (s.shape != t.shape) ||
+                (s.quant.scale != t.quant.scale) ||
+                (s.quant.zeroPoint != t.quant.zeroPoint) ||
+                (s.quant.axis != t.quant.axis))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    return same(a.getInputInfo(), b.getInputInfo()) &&
+           same(a.getOutputInfo(), b.getOutputInfo());
+}
+
+void DlModelHandle::worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        if (m_request)
+        {
+            InfererConfig   config = std::move(*m_request);
+            DLInferer      *inferer;
+            int32_t         status = 0;
+
+            m_request.reset();
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            inferer = DLInferer::makeInferer(config);
+            auto end = std::chrono::steady_clock::now();
+
+            if (inferer == nullptr)
+            {
+                DL_INFER_LOG_ERROR("Model swap failed, keeping the current "
+                                   "model.\n");
+                status = -1;
+            }
+            else
+            {
+                std::shared_ptr<DLInferer>  next(inferer);
+
+                m_retired.push_back(std::atomic_exchange(&m_current, next));
+                m_generation.fetch_add(1, std::memory_order_release);
+
+                DL_INFER_LOG_INFO("Model swapped in after %.2f ms.\n",
+                                  std::chrono::duration<float, std::milli>(
+                                      end - start).count());
+            }
+
+            lock.lock();
+            m_pending    = false;
+            m_swapStatus = status;
+            m_doneCv.notify_all();
+            continue;
+        }
+
+        /* Destroy the retired inferers nobody uses anymore. The destructor
+         * drains the asynchronous requests queued on them.
+         */
+        if (!m_retired.empty())
+        {
+            lock.unlock();
+
+            for (auto it = m_retired.begin(); it != m_retired.end();)
+            {
+                if (it->use_count() == 1)
+                {
+                    it = m_retired.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            lock.lock();
+        }
+
+        if (m_stop)
+        {
+            break;
+        }
+
+        if (m_retired.empty())
+        {
+            m_workerCv.wait(lock, [this]{ return m_stop || m_request; });
+        }
+        else
+        {
+            m_workerCv.wait_for(lock,
+                                std::chrono::milliseconds(HANDLE_REAP_INTERVAL_MS),
+                                [this]{ return m_stop || m_request; });
+        }
+    }
+}
+
+DlModelHandle::~DlModelHandle()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_doneCv.wait(lock, [this]{ return !m_pending; });
+        m_stop = true;
+        m_workerCv.notify_one();
+    }
+
+    m_worker.join();
+    m_retired.clear();
+}
+
+} // namespace ti::dl_inferer
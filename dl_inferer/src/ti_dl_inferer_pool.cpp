@@ -0,0 +1,276 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <atomic>
+
+/* Module headers. */
+#include <ti_dl_inferer_pool.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+#define POOL_HEAD_INDEX(_H)     ((uint32_t)((_H) & 0xFFFFFFFFull))
+#define POOL_HEAD_TAG(_H)       ((uint32_t)((_H) >> 32))
+#define POOL_MAKE_HEAD(_T, _I)  (((uint64_t)(_T) << 32) | (uint64_t)(_I))
+
+InfererPool::InfererPool(const InfererConfig &config)
+{
+    init(config, config.numInstances);
+}
+
+InfererPool::InfererPool(const InfererConfig   &config,
+                         int32_t                numInstances)
+{
+    init(config, numInstances);
+}
+
+void InfererPool::init(const InfererConfig &config, int32_t numInstances)
+{
+    if (numInstances <= 0)
+    {
+        throw std::runtime_error("InfererPool: invalid number of instances.");
+    }
+
+    m_next.reset(new std::atomic<uint32_t>[numInstances]);
+
+    for (int32_t i = 0; i < numInstances; i++)
+    {
+        DLInferer  *inferer = DLInferer::makeInferer(config);
+
+        if (inferer == nullptr)
+        {
+            for (auto *p : m_inferers)
+            {
+                delete p;
+            }
+
+            m_inferers.clear();
+            throw std::runtime_error("InfererPool object creation failed.");
+        }
+
+        m_inferers.push_back(inferer);
+        m_next[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (int32_t i = numInstances - 1; i >= 0; i--)
+    {
+        push(i);
+    }
+
+    DL_INFER_LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+void InfererPool::push(int32_t index)
+{
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    uint64_t newHead;
+
+    do
+    {
+        m_next[index].store(POOL_HEAD_INDEX(head), std::memory_order_relaxed);
+        newHead = POOL_MAKE_HEAD(POOL_HEAD_TAG(head) + 1, index + 1);
+
+    } while (!m_head.compare_exchange_weak(head, newHead,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+}
+
+int32_t InfererPool::pop()
+{
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    uint64_t newHead;
+    uint32_t index;
+
+    do
+    {
+        index = POOL_HEAD_INDEX(head);
+
+        if (index == 0)
+        {
+            return -1;
+        }
+
+        newHead = POOL_MAKE_HEAD(POOL_HEAD_TAG(head) + 1,
+                                 m_next[index - 1].load(std::memory_order_relaxed));
+
+    } while (!m_head.compare_exchange_weak(head, newHead,
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire));
+
+    return index - 1;
+}
+
+DLInferer *InfererPool::tryAcquire()
+{
+    int32_t index = pop();
+
+    return index < 0 ? nullptr : m_inferers[index];
+}
+
+DLInferer *InfererPool::acquire()
+{
+    DLInferer  *inferer = tryAcquire();
+
+    if (inferer != nullptr)
+    {
+        return inferer;
+    }
+
+    std::unique_lock<std::mutex>    lock(m_waitMutex);
+
+    /* Register before looking at the free-list again, release() pushes
+     * before looking at the waiters. One of the two sees the other.
+     */
+    m_numWaiters++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    m_waitCv.wait(lock, [&]{ return (inferer = tryAcquire()) != nullptr; });
+
+    m_numWaiters--;
+
+    return inferer;
+}
+
+void InfererPool::release(DLInferer *inferer)
+{
+    for (uint32_t i = 0; i < m_inferers.size(); i++)
+    {
+        if (m_inferers[i] == inferer)
+        {
+            push(i);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_numWaiters.load() > 0)
+            {
+                /* Taking the mutex orders the signal after the waiter has
+                 * either found the instance or gone to sleep.
+                 */
+                {
+                    std::unique_lock<std::mutex>    lock(m_waitMutex);
+                }
+
+                m_waitCv.notify_one();
+            }
+
+            return;
+        }
+    }
+
+    DL_INFER_LOG_ERROR("Inferer does not belong to the pool.\n");
+}
+
+int32_t InfererPool::run(const VecDlTensorPtr  &inputs,
+                         VecDlTensorPtr        &outputs)
+{
+    DLInferer  *inferer = acquire();
+    int32_t     status;
+
+    try
+    {
+        status = inferer->run(inputs, outputs);
+    }
+    catch (...)
+    {
+        release(inferer);
+        throw;
+    }
+
+    release(inferer);
+
+    return status;
+}
+
+int32_t InfererPool::getNumInstances() const
+{
+    return m_inferers.size();
+}
+
+const VecDlTensor *InfererPool::getInputInfo()
+{
+    return m_inferers[0]->getInputInfo();
+}
+
+const VecDlTensor *InfererPool::getOutputInfo()
+{
+    return m_inferers[0]->getOutputInfo();
+}
+
+int32_t InfererPool::createBuffers(const VecDlTensor   *ifInfoList,
+                                   VecDlTensorPtr      &vecVar,
+                                   bool                 allocate)
+{
+    return m_inferers[0]->createBuffers(ifInfoList, vecVar, allocate);
+}
+
+InfererPool::~InfererPool()
+{
+    DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
+
+    for (auto *p : m_inferers)
+    {
+        delete p;
+    }
+}
+
+} // namespace ti::dl_inferer
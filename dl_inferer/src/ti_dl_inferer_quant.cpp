@@ -0,0 +1,401 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/* Module headers. */
+#include <ti_dl_inferer_quant.h>
+#include <ti_dl_inferer_fp16.h>
+
+namespace ti::dl_inferer
+{
+#if defined(__aarch64__)
+/* Dequantizes 8 values widened to 16 bits. */
+static inline void dequantize8(int16x8_t        q,
+                               float           *dst,
+                               int32x4_t        zp,
+                               float32x4_t      scale)
+{
+    int32x4_t lo = vsubq_s32(vmovl_s16(vget_low_s16(q)), zp);
+    int32x4_t hi = vsubq_s32(vmovl_high_s16(q), zp);
+
+    vst1q_f32(dst,     vmulq_f32(vcvtq_f32_s32(lo), scale));
+    vst1q_f32(dst + 4, vmulq_f32(vcvtq_f32_s32(hi), scale));
+}
+#endif
+
+template <typename T>
+static void dequantizeScalar(const T   *src,
+                             float     *dst,
+                             int64_t    numElem,
+                             float      scale,
+                             int32_t    zeroPoint)
+{
+    for (int64_t i = 0; i < numElem; i++)
+    {
+        dst[i] = (static_cast<float>(src[i]) - zeroPoint) * scale;
+    }
+}
+
+/* Returns the range of the stored values of a type. */
+static void getTypeRange(DlInferType type, float &minVal, float &maxVal)
+{
+    switch (type)
+    {
+        case DlInferType_Int8:
+            minVal = std::numeric_limits<int8_t>::min();
+            maxVal = std::numeric_limits<int8_t>::max();
+            break;
+
+        case DlInferType_UInt8:
+            minVal = std::numeric_limits<uint8_t>::min();
+            maxVal = std::numeric_limits<uint8_t>::max();
+            break;
+
+        case DlInferType_Int16:
+            minVal = std::numeric_limits<int16_t>::min();
+            maxVal = std::numeric_limits<int16_t>::max();
+            break;
+
+        case DlInferType_UInt16:
+            minVal = std::numeric_limits<uint16_t>::min();
+            maxVal = std::numeric_limits<uint16_t>::max();
+            break;
+
+        default:
+            minVal = std::numeric_limits<int32_t>::min();
+            maxVal = std::numeric_limits<int32_t>::max();
+            break;
+    }
+}
+
+/* Dequantizes a range of elements sharing the same parameters. */
+static void dequantizeRun(const DlTensor   &t,
+                          int64_t           begin,
+                          int64_t           count,
+                          float            *dst,
+                          float             scale,
+                          int32_t           zeroPoint)
+{
+    switch (t.type)
+    {
+        case DlInferType_Int8:
+            dequantize(reinterpret_cast<const int8_t*>(t.data) + begin,
+                       dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_UInt8:
+            dequantize(reinterpret_cast<const uint8_t*>(t.data) + begin,
+                       dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_Int16:
+            dequantizeScalar(reinterpret_cast<const int16_t*>(t.data) + begin,
+                             dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_UInt16:
+            dequantizeScalar(reinterpret_cast<const uint16_t*>(t.data) + begin,
+                             dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_Int32:
+            dequantizeScalar(reinterpret_cast<const int32_t*>(t.data) + begin,
+                             dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_UInt32:
+            dequantizeScalar(reinterpret_cast<const uint32_t*>(t.data) + begin,
+                             dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_Int64:
+            dequantizeScalar(reinterpret_cast<const int64_t*>(t.data) + begin,
+                             dst, count, scale, zeroPoint);
+            break;
+
+        case DlInferType_Float16:
+            convertFp16ToFp32(reinterpret_cast<const uint16_t*>(t.data) + begin,
+                              dst, count);
+            break;
+
+        case DlInferType_Float32:
+            std::memcpy(dst, reinterpret_cast<const float*>(t.data) + begin,
+                        count * sizeof(float));
+            break;
+
+        default:
+            std::fill(dst, dst + count, 0.0f);
+            break;
+    }
+}
+
+/* Number of consecutive elements sharing the same per-channel parameters. */
+static int64_t getChannelRun(const DlTensor &t)
+{
+    int64_t run = 1;
+
+    for (int32_t d = t.quant.axis + 1; d < t.dim; d++)
+    {
+        run *= t.shape[d];
+    }
+
+    return run;
+}
+
+void getQuantParams(const DlTensor &t,
+                    int64_t         index,
+                    float          &scale,
+                    int32_t        &zeroPoint)
+{
+    const auto     &q = t.quant;
+    size_t          ch = 0;
+
+    if (q.scale.empty())
+    {
+        scale     = 1.0f;
+        zeroPoint = 0;
+        return;
+    }
+
+    if ((q.scale.size() > 1) && (q.axis >= 0) && (q.axis < t.dim))
+    {
+        ch = (index / getChannelRun(t)) % t.shape[q.axis];
+        ch = std::min(ch, q.scale.size() - 1);
+    }
+
+    scale     = q.scale[ch];
+    zeroPoint = q.zeroPoint[ch];
+}
+
+float getRawValue(const DlTensor &t, int64_t index)
+{
+    switch (t.type)
+    {
+        case DlInferType_Int8:
+            return reinterpret_cast<const int8_t*>(t.data)[index];
+
+        case DlInferType_UInt8:
+            return reinterpret_cast<const uint8_t*>(t.data)[index];
+
+        case DlInferType_Int16:
+            return reinterpret_cast<const int16_t*>(t.data)[index];
+
+        case DlInferType_UInt16:
+            return reinterpret_cast<const uint16_t*>(t.data)[index];
+
+        case DlInferType_Int32:
+            return reinterpret_cast<const int32_t*>(t.data)[index];
+
+        case DlInferType_UInt32:
+            return reinterpret_cast<const uint32_t*>(t.data)[index];
+
+        case DlInferType_Int64:
+            return reinterpret_cast<const int64_t*>(t.data)[index];
+
+        case DlInferType_Float16:
+            return fp16ToFp32(reinterpret_cast<const uint16_t*>(t.data)[index]);
+
+        case DlInferType_Float32:
+            return reinterpret_cast<const float*>(t.data)[index];
+
+        default:
+            return 0.0f;
+    }
+}
+
+float getValue(const DlTensor &t, int64_t index)
+{
+    float   raw = getRawValue(t, index);
+    float   scale;
+    int32_t zeroPoint;
+
+    if (!t.isQuantized())
+    {
+        return raw;
+    }
+
+    getQuantParams(t, index, scale, zeroPoint);
+
+    return (raw - zeroPoint) * scale;
+}
+
+float quantizeThreshold(const DlTensor &t, int64_t index, float threshold)
+{
+    float   scale;
+    int32_t zeroPoint;
+
+    if (!t.isQuantized())
+    {
+        return threshold;
+    }
+
+    getQuantParams(t, index, scale, zeroPoint);
+
+    return threshold / scale + zeroPoint;
+}
+
+float quantizeValue(const DlTensor &t, int64_t index, float value)
+{
+    float   minVal;
+    float   maxVal;
+
+    if (!t.isQuantized())
+    {
+        return value;
+    }
+
+    getTypeRange(t.type, minVal, maxVal);
+
+    value = std::nearbyint(quantizeThreshold(t, index, value));
+
+    return std::min(std::max(value, minVal), maxVal);
+}
+
+void dequantize(const DlTensor &t,
+                int64_t         begin,
+                int64_t         count,
+                float          *dst)
+{
+    float   scale;
+    int32_t zeroPoint;
+
+    if (t.quant.scale.size() <= 1)
+    {
+        getQuantParams(t, begin, scale, zeroPoint);
+        dequantizeRun(t, begin, count, dst, scale, zeroPoint);
+        return;
+    }
+
+    /* Per-channel, one run per change of channel. */
+    int64_t chRun = getChannelRun(t);
+
+    while (count > 0)
+    {
+        int64_t n = std::min(chRun - (begin % chRun), count);
+
+        getQuantParams(t, begin, scale, zeroPoint);
+        dequantizeRun(t, begin, n, dst, scale, zeroPoint);
+
+        begin += n;
+        dst   += n;
+        count -= n;
+    }
+}
+
+void dequantize(const int8_t   *src,
+                float          *dst,
+                int64_t         numElem,
+                float           scale,
+                int32_t         zeroPoint)
+{
+    int64_t i = 0;
+
+#if defined(__aarch64__)
+    int32x4_t   vZp = vdupq_n_s32(zeroPoint);
+    float32x4_t vScale = vdupq_n_f32(scale);
+
+    for (; i + 16 <= numElem; i += 16)
+    {
+        int8x16_t q = vld1q_s8(src + i);
+
+        dequantize8(vmovl_s8(vget_low_s8(q)), dst + i,     vZp, vScale);
+        dequantize8(vmovl_high_s8(q),         dst + i + 8, vZp, vScale);
+    }
+#endif
+
+    dequantizeScalar(src + i, dst + i, numElem - i, scale, zeroPoint);
+}
+
+void dequantize(const uint8_t  *src,
+                float          *dst,
+                int64_t         numElem,
+                float           scale,
+                int32_t         zeroPoint)
+{
+    int64_t i = 0;
+
+#if defined(__aarch64__)
+    int32x4_t   vZp = vdupq_n_s32(zeroPoint);
+    float32x4_t vScale = vdupq_n_f32(scale);
+
+    for (; i + 16 <= numElem; i += 16)
+    {
+        uint8x16_t q = vld1q_u8(src + i);
+
+        dequantize8(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(q))),
+                    dst + i, vZp, vScale);
+        dequantize8(vreinterpretq_s16_u16(vmovl_high_u8(q)),
+                    dst + i + 8, vZp, vScale);
+    }
+#endif
+
+    dequantizeScalar(src + i, dst + i, numElem - i, scale, zeroPoint);
+}
+
+} // namespace ti::dl_inferer
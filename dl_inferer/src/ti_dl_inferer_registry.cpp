@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Module headers. */
+#include <ti_dl_inferer_registry.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+DlModelRegistry &DlModelRegistry::getInstance()
+{
+    /* Never destroyed so that the inferers destroyed during the static
+     * destruction can still look it up.
+     */
+    static DlModelRegistry *registry = new DlModelRegistry();
+
+    return *registry;
+}
+
+std::shared_ptr<DlModelRegistry::Entry>
+DlModelRegistry::getEntry(const std::string &key)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    auto                           &entry = m_entries[key];
+
+    if (entry == nullptr)
+    {
+        entry = std::make_shared<Entry>();
+    }
+
+    return entry;
+}
+
+int64_t DlModelRegistry::getUseCount(const std::string &key)
+{
+    std::shared_ptr<Entry>  entry;
+
+    {
+        std::unique_lock<std::mutex>    lock(m_mutex);
+        auto                            it = m_entries.find(key);
+
+        if (it == m_entries.end())
+        {
+            return 0;
+        }
+
+        entry = it->second;
+    }
+
+    std::unique_lock<std::mutex>    lock(entry->mutex);
+
+    return entry->object.use_count();
+}
+
+void DlModelRegistry::dumpInfo()
+{
+    std::map<std::string, std::shared_ptr<Entry>>  entries;
+
+    {
+        std::unique_lock<std::mutex>    lock(m_mutex);
+
+        entries = m_entries;
+    }
+
+    for (const auto &[key, entry] : entries)
+    {
+        std::unique_lock<std::mutex>    lock(entry->mutex);
+        auto                            count = entry->object.use_count();
+
+        if (count > 0)
+        {
+            DL_INFER_LOG_INFO("Shared [%s] users = %ld\n", key.c_str(), count);
+        }
+    }
+}
+
+} // namespace ti::dl_inferer
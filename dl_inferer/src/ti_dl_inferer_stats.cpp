@@ -0,0 +1,222 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+/* Module headers. */
+#include <ti_dl_inferer_stats.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+DlLatencyHistogram::DlLatencyHistogram()
+{
+    reset();
+}
+
+uint64_t DlLatencyHistogram::now()
+{
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+int32_t DlLatencyHistogram::getBucket(uint64_t value)
+{
+    int32_t msb;
+    int32_t shift;
+
+    /* The values below the first power of two range are exact. */
+    if (value < (1u << SUB_BUCKET_BITS))
+    {
+        return value;
+    }
+
+    msb   = 63 - __builtin_clzll(value);
+    shift = msb - SUB_BUCKET_BITS;
+
+    /* The bits following the most significant one select the bucket. */
+    return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) +
+           ((value >> shift) & ((1u << SUB_BUCKET_BITS) - 1));
+}
+
+uint64_t DlLatencyHistogram::getBucketValue(int32_t bucket)
+{
+    int32_t     shift;
+    uint64_t    low;
+
+    if (bucket < (1 << SUB_BUCKET_BITS))
+    {
+        return bucket;
+    }
+
+    shift = (bucket >> SUB_BUCKET_BITS) - 1;
+    low   = static_cast<uint64_t>((1 << SUB_BUCKET_BITS) +
+                                  (bucket & ((1 << SUB_BUCKET_BITS) - 1))) << shift;
+
+    return low + ((1ull << shift) >> 1);
+}
+
+void DlLatencyHistogram::record(uint64_t latencyNs)
+{
+    uint64_t    end = now();
+    uint64_t    start = end - latencyNs;
+    uint64_t    prev;
+
+    m_buckets[getBucket(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+    m_sumNs.fetch_add(latencyNs, std::memory_order_relaxed);
+
+    prev = m_maxNs.load(std::memory_order_relaxed);
+
+    while ((prev < latencyNs) &&
+           !m_maxNs.compare_exchange_weak(prev, latencyNs,
+                                          std::memory_order_relaxed))
+    {
+    }
+
+    prev = 0;
+    m_firstNs.compare_exchange_strong(prev, start, std::memory_order_relaxed);
+    m_lastNs.store(end, std::memory_order_relaxed);
+
+    /* Counted last so that a reader seeing the call sees its data. */
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+DlLatencyStats DlLatencyHistogram::getStats() const
+{
+    DlLatencyStats  stats;
+    const double    percentiles[] = {0.5, 0.9, 0.99};
+    double         *results[] = {&stats.p50Ms, &stats.p90Ms, &stats.p99Ms};
+    uint64_t        total = 0;
+    uint64_t        maxNs;
+    uint64_t        seen = 0;
+    int32_t         p = 0;
+
+    stats.count = m_count.load(std::memory_order_acquire);
+
+    if (stats.count == 0)
+    {
+        return stats;
+    }
+
+    maxNs = m_maxNs.load(std::memory_order_relaxed);
+
+    /* The buckets may run ahead of the count while calls are recorded. */
+    for (int32_t i = 0; i < NUM_BUCKETS; i++)
+    {
+        total += m_buckets[i].load(std::memory_order_relaxed);
+    }
+
+    for (int32_t i = 0; (i < NUM_BUCKETS) && (p < 3); i++)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+
+        while ((p < 3) && (seen >= std::ceil(percentiles[p] * total)))
+        {
+            *results[p] = std::min(getBucketValue(i), maxNs) / 1e6;
+            p++;
+        }
+    }
+
+    stats.meanMs = m_sumNs.load(std::memory_order_relaxed) / 1e6 / stats.count;
+    stats.maxMs  = maxNs / 1e6;
+
+    uint64_t span = m_lastNs.load(std::memory_order_relaxed) -
+                    m_firstNs.load(std::memory_order_relaxed);
+
+    if (span > 0)
+    {
+        stats.callsPerSec = stats.count * 1e9 / span;
+    }
+
+    return stats;
+}
+
+void DlLatencyHistogram::reset()
+{
+    for (auto &b : m_buckets)
+    {
+        b.store(0, std::memory_order_relaxed);
+    }
+
+    m_sumNs.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+    m_firstNs.store(0, std::memory_order_relaxed);
+    m_lastNs.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_release);
+}
+
+void DlLatencyHistogram::dumpInfo(const std::string &label) const
+{
+    DlLatencyStats  s = getStats();
+
+    DL_INFER_LOG_INFO("%s: count = %lu mean = %.3fms p50 = %.3fms "
+                      "p90 = %.3fms p99 = %.3fms max = %.3fms rate = %.1f/s\n",
+                      label.c_str(), s.count, s.meanMs, s.p50Ms, s.p90Ms,
+                      s.p99Ms, s.maxMs, s.callsPerSec);
+}
+
+} // namespace ti::dl_inferer
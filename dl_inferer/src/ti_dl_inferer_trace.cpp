@@ -0,0 +1,297 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <algorithm>
+
+/* Module headers. */
+#include <ti_dl_inferer_trace.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+#define DL_INFER_TRACE_ENV  "DL_INFER_TRACE"
+
+static void dumpAtExit()
+{
+    const char *fileName = getenv(DL_INFER_TRACE_ENV);
+
+    if ((fileName != nullptr) && (fileName[0] != '\0'))
+    {
+        DlTracer::getInstance().dump(fileName);
+    }
+}
+
+DlTracer &DlTracer::getInstance()
+{
+    /* Never destroyed so that the spans can be dumped from an exit
+     * handler and recorded during the static destruction.
+     */
+    static DlTracer    *tracer = []()
+    {
+        DlTracer   *t = new DlTracer();
+        const char *fileName = getenv(DL_INFER_TRACE_ENV);
+
+        if ((fileName != nullptr) && (fileName[0] != '\0'))
+        {
+            t->enable(true);
+            atexit(dumpAtExit);
+        }
+
+        return t;
+    }();
+
+    return *tracer;
+}
+
+void DlTracer::enable(bool enable)
+{
+    m_enabled.store(enable, std::memory_order_relaxed);
+}
+
+DlTracer::ThreadRing *DlTracer::acquireThreadRing()
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    ThreadRing                     *ring;
+
+    if (m_freeRings.empty())
+    {
+        m_rings.emplace_back(new ThreadRing());
+        m_freeRings.reserve(m_rings.size());
+        ring = m_rings.back().get();
+    }
+    else
+    {
+        /* Drop the spans of the previous owner, which would otherwise be
+         * reported with the new thread Id.
+         */
+        ring = m_freeRings.back();
+        m_freeRings.pop_back();
+        ring->tail.store(ring->head.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    }
+
+    ring->tid = syscall(SYS_gettid);
+
+    return ring;
+}
+
+void DlTracer::releaseThreadRing(ThreadRing *ring)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    m_freeRings.push_back(ring);
+}
+
+DlTracer::ThreadRing *DlTracer::getThreadRing()
+{
+    /* Trivially destructible, hence still usable by the spans recorded
+     * from the thread-local destructors.
+     */
+    thread_local ThreadRing    *ring = nullptr;
+    thread_local bool           exiting = false;
+
+    /* Hands the ring back when the thread exits. */
+    struct RingOwner
+    {
+        ~RingOwner()
+        {
+            DlTracer::getInstance().releaseThreadRing(ring);
+            ring    = nullptr;
+            exiting = true;
+        }
+    };
+
+    if ((ring == nullptr) && !exiting)
+    {
+        ring = acquireThreadRing();
+
+        thread_local RingOwner  owner;
+    }
+
+    return ring;
+}
+
+void DlTracer::record(const char *name, uint64_t startNs, uint64_t endNs)
+{
+    ThreadRing *ring = getThreadRing();
+
+    if (ring == nullptr)
+    {
+        return;
+    }
+
+    uint64_t    h = ring->head.load(std::memory_order_relaxed);
+    Span       &span = ring->spans[h % RING_SIZE];
+
+    /* Sequence lock, dump() skips the span unless 'seq' is the same before
+     * and after reading it.
+     */
+    span.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    span.name.store(name, std::memory_order_relaxed);
+    span.startNs.store(startNs, std::memory_order_relaxed);
+    span.endNs.store(endNs, std::memory_order_relaxed);
+    span.seq.store(h + 1, std::memory_order_release);
+    ring->head.store(h + 1, std::memory_order_release);
+}
+
+/* Writes a string as a JSON string literal. */
+static void writeJsonString(FILE *fp, const char *s)
+{
+    fputc('"', fp);
+
+    for (; *s != '\0'; s++)
+    {
+        if ((*s == '"') || (*s == '\\'))
+        {
+            fputc('\\', fp);
+        }
+
+        fputc(*s, fp);
+    }
+
+    fputc('"', fp);
+}
+
+int32_t DlTracer::dump(const std::string &fileName)
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+    FILE                           *fp;
+    int32_t                         pid = getpid();
+    bool                            first = true;
+    uint64_t                        numSpans = 0;
+
+    fp = fopen(fileName.c_str(), "w");
+
+    if (fp == nullptr)
+    {
+        DL_INFER_LOG_ERROR("Failed to open [%s].\n", fileName.c_str());
+        return -1;
+    }
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+
+    for (const auto &ring : m_rings)
+    {
+        uint64_t    head = ring->head.load(std::memory_order_acquire);
+        uint64_t    begin = ring->tail.load(std::memory_order_relaxed);
+
+        if (head - begin > RING_SIZE)
+        {
+            begin = head - RING_SIZE;
+        }
+
+        for (uint64_t i = begin; i < head; i++)
+        {
+            const Span &span = ring->spans[i % RING_SIZE];
+            uint64_t    seq = span.seq.load(std::memory_order_acquire);
+            const char *name = span.name.load(std::memory_order_relaxed);
+            uint64_t    startNs = span.startNs.load(std::memory_order_relaxed);
+            uint64_t    endNs = span.endNs.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            /* Overwritten by the owning thread since 'head' was read. */
+            if ((seq != i + 1) ||
+                (span.seq.load(std::memory_order_relaxed) != seq))
+            {
+                continue;
+            }
+
+            fprintf(fp, "%s{\"name\":", first ? "" : ",\n");
+            writeJsonString(fp, name);
+            fprintf(fp, ",\"cat\":\"dl_inferer\",\"ph\":\"X\","
+                        "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                    startNs / 1e3, (endNs - startNs) / 1e3,
+                    pid, ring->tid);
+
+            first = false;
+            numSpans++;
+        }
+    }
+
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(fp);
+
+    DL_INFER_LOG_INFO("Wrote %lu spans to [%s].\n", numSpans, fileName.c_str());
+
+    return 0;
+}
+
+void DlTracer::clear()
+{
+    std::unique_lock<std::mutex>    lock(m_mutex);
+
+    for (auto &ring : m_rings)
+    {
+        ring->tail.store(ring->head.load(std::memory_order_acquire),
+                         std::memory_order_relaxed);
+    }
+}
+
+} // namespace ti::dl_inferer
@@ -89,7 +89,7 @@ static int32_t type2Size(const char *s, DlInferType &tiType)
     }
     else if (!strcmp(s, "float16"))
     {
-        size = sizeof(float);
+        size = sizeof(uint16_t);
         tiType = DlInferType_Float16;
     }
     else if (!strcmp(s, "int32"))
@@ -185,7 +185,9 @@ int32_t DLRInferer::populateInputInfo()
     if (status == 0)
     {
         // Reserve the storage
-        m_inputs.assign(numInfo, DlTensor());
+        m_inputs.clear();
+        m_inputs.resize(numInfo);
+        m_packedInputs.resize(numInfo);
 
         for (int32_t i = 0; i < numInfo; i++)
         {
@@ -278,7 +280,8 @@ int32_t DLRInferer::populateOutputInfo()
     if (status == 0)
     {
         // Reserve the storage
-        m_outputs.assign(numInfo, DlTensor());
+        m_outputs.clear();
+        m_outputs.resize(numInfo);
 
         for (int32_t i = 0; i < numInfo; i++)
         {
@@ -352,6 +355,9 @@ int32_t DLRInferer::populateOutputInfo()
 int32_t DLRInferer::run(const VecDlTensorPtr &inputs,
                         VecDlTensorPtr       &outputs)
 {
+    DlLatencyScope  latency(m_runStats);
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_TRACE_SCOPE("DLRInferer::run");
     DL_INFER_GET_EXCL_ACCESS;
     int32_t status = 0;
 
@@ -369,45 +375,7 @@ int32_t DLRInferer::run(const VecDlTensorPtr &inputs,
     /* Set inputs. */
     if (status == 0)
     {
-        for (uint32_t i = 0; i < m_inputs.size(); i++)
-        {
-            DlTensor  *info = &m_inputs[i];
-            DLTensor dltensor;
-            auto cfunc = [info]() {
-                std::map<DlInferType, DLDataTypeCode> cmap = {
-                    {DlInferType_Int8,    kDLInt},
-                    {DlInferType_Int16,   kDLInt},
-                    {DlInferType_Int32,   kDLInt},
-                    {DlInferType_Int64,   kDLInt},
-                    {DlInferType_UInt8,   kDLUInt},
-                    {DlInferType_UInt16,  kDLUInt},
-                    {DlInferType_UInt32,  kDLUInt},
-                    {DlInferType_Float16, kDLFloat},
-                    {DlInferType_Float32, kDLFloat},
-                };
-                return cmap[info->type];
-            };
-
-            dltensor.ndim = info->dim;
-            dltensor.shape = info->shape.data();
-            dltensor.strides = nullptr;
-            dltensor.byte_offset = 0;
-            dltensor.dtype = {cfunc(),
-                              static_cast<uint8_t>(info->elemSize * 8),
-                              1};
-            dltensor.data = inputs[i]->data;
-
-            status = SetDLRInputTensorZeroCopy(&m_handle,
-                                 info->name,
-                                 &dltensor);
-
-            if (status < 0)
-            {
-                DL_INFER_LOG_ERROR("SetDLRInputTensorZeroCopy(%d) failed.\n",
-                                   i);
-                break;
-            }
-        }
+        status = bindBuffers(inputs, outputs);
     }
 
     /* Run the model. */
@@ -439,6 +407,66 @@ int32_t DLRInferer::run(const VecDlTensorPtr &inputs,
     return status;
 }
 
+int32_t DLRInferer::bindBuffers(const VecDlTensorPtr &inputs,
+                                VecDlTensorPtr       &/*outputs*/)
+{
+    static const std::map<DlInferType, DLDataTypeCode> cmap = {
+        {DlInferType_Int8,    kDLInt},
+        {DlInferType_Int16,   kDLInt},
+        {DlInferType_Int32,   kDLInt},
+        {DlInferType_Int64,   kDLInt},
+        {DlInferType_UInt8,   kDLUInt},
+        {DlInferType_UInt16,  kDLUInt},
+        {DlInferType_UInt32,  kDLUInt},
+        {DlInferType_Float16, kDLFloat},
+        {DlInferType_Float32, kDLFloat},
+    };
+    int32_t status = 0;
+
+    m_boundInputs.resize(m_inputs.size(), nullptr);
+
+    for (uint32_t i = 0; i < m_inputs.size(); i++)
+    {
+        DlTensor   *info = &m_inputs[i];
+        void       *data = getPackedData(inputs[i], m_packedInputs[i]);
+        DLTensor    dltensor;
+
+        /* DLR keeps pointing to the buffer across the runs. */
+        if (data == m_boundInputs[i])
+        {
+            continue;
+        }
+
+        dltensor.ndim = info->dim;
+        dltensor.shape = info->shape.data();
+        /* The zero-copy input has to be compact and hence strided
+         * inputs get packed first.
+         */
+        dltensor.strides = nullptr;
+        dltensor.byte_offset = 0;
+        dltensor.dtype = {cmap.at(info->type),
+                          static_cast<uint8_t>(info->elemSize * 8),
+                          1};
+        dltensor.data = data;
+
+        status = SetDLRInputTensorZeroCopy(&m_handle,
+                             info->name,
+                             &dltensor);
+
+        if (status < 0)
+        {
+            DL_INFER_LOG_ERROR("SetDLRInputTensorZeroCopy(%d) failed.\n",
+                               i);
+            m_boundInputs[i] = nullptr;
+            break;
+        }
+
+        m_boundInputs[i] = data;
+    }
+
+    return status;
+}
+
 void DLRInferer::dumpInfo()
 {
     DL_INFER_LOG_INFO("Model Path        = %s\n", m_name.c_str());
@@ -482,6 +510,9 @@ DLRInferer::~DLRInferer()
 
     DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
 
+    /* Drain any pending asynchronous requests. */
+    stopAsync();
+
     /* Delete the DLR Model handle. */
     status = DeleteDLRModel(&m_handle);
 
@@ -492,12 +523,8 @@ DLRInferer::~DLRInferer()
     }
 }
 
-void *DLRInferer::allocate(int64_t size)
+int32_t DLRInferer::getBufferAlignment()
 {
-    auto align = [](int alignment, int64_t size) {
-        return alignment * ((size + (alignment - 1)) / alignment);
-    };
-    return aligned_alloc(128, align(128, size));
-
+    return 128;
 }
 } // namespace ti::dl_inferer
@@ -0,0 +1,613 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+/* Module headers. */
+#include <ti_null_inferer.h>
+#include <ti_dl_inferer_fp16.h>
+#include <ti_dl_inferer_quant.h>
+#include <ti_dl_inferer_registry.h>
+#include <ti_dl_inferer_logger.h>
+
+using namespace ti::dl_inferer::utils;
+
+namespace ti::dl_inferer
+{
+static DlInferType Null2TiInferType(const std::string  &name,
+                                    const char        **typeName)
+{
+    static const struct
+    {
+        const char     *name;
+        DlInferType     type;
+    } types[] = {
+        {"int8",    DlInferType_Int8},
+        {"uint8",   DlInferType_UInt8},
+        {"int16",   DlInferType_Int16},
+        {"uint16",  DlInferType_UInt16},
+        {"int32",   DlInferType_Int32},
+        {"uint32",  DlInferType_UInt32},
+        {"int64",   DlInferType_Int64},
+        {"float16", DlInferType_Float16},
+        {"float32", DlInferType_Float32},
+    };
+
+    for (const auto &t : types)
+    {
+        if (name == t.name)
+        {
+            *typeName = t.name;
+            return t.type;
+        }
+    }
+
+    *typeName = "invalid";
+    return DlInferType_Invalid;
+}
+
+static void setValue(DlTensor *tensor, int64_t index, float value)
+{
+    /* The value is a real one, store its quantized form. */
+    value = quantizeValue(*tensor, index, value);
+
+    switch (tensor->type)
+    {
+        case DlInferType_Int8:
+            reinterpret_cast<int8_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_UInt8:
+            reinterpret_cast<uint8_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_Int16:
+            reinterpret_cast<int16_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_UInt16:
+            reinterpret_cast<uint16_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_Int32:
+            reinterpret_cast<int32_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_UInt32:
+            reinterpret_cast<uint32_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_Int64:
+            reinterpret_cast<int64_t*>(tensor->data)[index] = value;
+            break;
+
+        case DlInferType_Float16:
+            reinterpret_cast<uint16_t*>(tensor->data)[index] = fp32ToFp16(value);
+            break;
+
+        case DlInferType_Float32:
+            reinterpret_cast<float*>(tensor->data)[index] = value;
+            break;
+
+        default:
+            break;
+    }
+}
+
+NullInferer::NullInferer(const NullInfererSpec &spec, bool shareModel):
+    m_spec(spec),
+    m_rng(spec.seed)
+{
+    int32_t status;
+
+    status = populateInfo(m_spec.inputs, m_inputs, true);
+
+    if (status == 0)
+    {
+        status = populateInfo(m_spec.outputs, m_outputs, false);
+    }
+
+    if ((status == 0) && m_spec.formatter.size() != 6)
+    {
+        DL_INFER_LOG_ERROR("Invalid detection formatter.\n");
+        status = -1;
+    }
+
+    if ((status == 0) &&
+        ((m_spec.fill == "detection") || (m_spec.fill == "classmap")) &&
+        m_spec.labels.empty() && (m_spec.numClasses < 1))
+    {
+        DL_INFER_LOG_ERROR("At least one class or label is needed.\n");
+        status = -1;
+    }
+
+    /* Every box field must fall within a row of each output. */
+    if ((status == 0) && (m_spec.fill == "detection"))
+    {
+        for (const auto &info : m_outputs)
+        {
+            int64_t rowSize = (info.dim > 0) ? info.shape[info.dim - 1] : 1;
+
+            for (const auto f : m_spec.formatter)
+            {
+                if ((f < 0) || (f >= rowSize))
+                {
+                    DL_INFER_LOG_ERROR("Formatter index %d out of the rows "
+                                       "of output [%s].\n", f, info.name);
+                    status = -1;
+                }
+            }
+        }
+    }
+
+    if (status < 0)
+    {
+        throw std::runtime_error("NullInferer object creation failed.");
+    }
+
+    /* Batch like a model whose inputs only have a dynamic batch size. */
+    m_dynamicBatch = !m_inputs.empty();
+
+    for (const auto &info : m_inputs)
+    {
+        if ((info.dim < 2) || (info.shape[0] >= 0) ||
+            std::any_of(info.shape.begin() + 1, info.shape.end(),
+                        [](int64_t d){ return d < 0; }))
+        {
+            m_dynamicBatch = false;
+        }
+    }
+
+    for (const auto &info : m_outputs)
+    {
+        if ((info.dim == 0) || (info.shape[0] != 1))
+        {
+            m_dynamicBatch = false;
+        }
+    }
+
+    if (m_spec.weightsBytes > 0)
+    {
+        auto makeWeights = [this]()
+        {
+            return std::make_shared<std::vector<uint8_t>>(m_spec.weightsBytes,
+                                                          m_spec.seed | 1);
+        };
+
+        if (shareModel)
+        {
+            m_weights = DlModelRegistry::getInstance().
+                            getOrCreate<std::vector<uint8_t>>(
+                                "null:" + std::to_string(m_spec.weightsBytes) +
+                                ":" + std::to_string(m_spec.seed),
+                                makeWeights);
+        }
+        else
+        {
+            m_weights = makeWeights();
+        }
+    }
+
+    /* Assume an image input to scale the detection boxes. */
+    if (!m_spec.normDetect && !m_inputs.empty() && (m_inputs[0].dim == 4) &&
+        (m_inputs[0].size > 0))
+    {
+        const auto &shape = m_inputs[0].shape;
+        bool        nchw = shape[1] <= 4;
+
+        m_height = nchw ? shape[2] : shape[1];
+        m_width  = nchw ? shape[3] : shape[2];
+    }
+
+    DL_INFER_LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+int32_t NullInferer::populateInfo(const std::vector<NullTensorSpec> &specs,
+                                  VecDlTensor                       &vec,
+                                  bool                               allowDynamic)
+{
+    vec.clear();
+    vec.resize(specs.size());
+
+    for (uint32_t i = 0; i < specs.size(); i++)
+    {
+        const NullTensorSpec   &spec = specs[i];
+        DlTensor               *info = &vec[i];
+
+        info->name     = spec.name.c_str();
+        info->type     = Null2TiInferType(spec.type, &info->typeName);
+        info->elemSize = getTypeSize(info->type);
+        info->shape    = spec.shape;
+        info->dim      = spec.shape.size();
+        info->quant.scale     = spec.scale;
+        info->quant.zeroPoint = spec.zeroPoint;
+        info->quant.axis      = spec.quantAxis;
+        info->numElem  = 1;
+
+        for (const auto d : spec.shape)
+        {
+            info->numElem *= d;
+        }
+
+        /* A negative dimension is set by the caller on every run. */
+        if (allowDynamic &&
+            std::any_of(spec.shape.begin(), spec.shape.end(),
+                        [](int64_t d){ return d < 0; }))
+        {
+            info->numElem = -1;
+        }
+        else if (info->numElem <= 0)
+        {
+            info->numElem = 0;
+        }
+
+        info->size = info->numElem * info->elemSize;
+
+        if ((info->type == DlInferType_Invalid) || (info->size == 0))
+        {
+            DL_INFER_LOG_ERROR("Invalid tensor [%s] specification.\n",
+                               spec.name.c_str());
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void NullInferer::fillOutput(DlTensor *tensor, const void *echo, int64_t echoSize)
+{
+    const std::string  &fill = m_spec.fill;
+    bool                isFloat = (tensor->type == DlInferType_Float32) ||
+                                  (tensor->type == DlInferType_Float16) ||
+                                  tensor->isQuantized();
+    int32_t             numClasses = m_spec.numClasses;
+
+    if (fill == "random")
+    {
+        std::uniform_real_distribution<float> dist(0.0f, isFloat ? 1.0f : 127.0f);
+
+        for (int64_t i = 0; i < tensor->numElem; i++)
+        {
+            setValue(tensor, i, dist(m_rng));
+        }
+    }
+    else if (fill == "logits")
+    {
+        std::uniform_real_distribution<float> dist(0.0f, isFloat ? 1.0f : 100.0f);
+
+        for (int64_t i = 0; i < tensor->numElem; i++)
+        {
+            setValue(tensor, i, dist(m_rng));
+        }
+    }
+    else if (fill == "classmap")
+    {
+        std::uniform_int_distribution<int32_t> dist(0, numClasses - 1);
+
+        for (int64_t i = 0; i < tensor->numElem; i++)
+        {
+            setValue(tensor, i, dist(m_rng));
+        }
+    }
+    else if (fill == "detection")
+    {
+        const auto                             &f = m_spec.formatter;
+        int64_t                                 rowSize;
+        int64_t                                 numRows;
+        int32_t                                 numLabels;
+        std::uniform_real_distribution<float>   dist(0.0f, 1.0f);
+
+        rowSize   = (tensor->dim > 0) ? tensor->shape[tensor->dim - 1] : 1;
+        numRows   = tensor->numElem/rowSize;
+        numLabels = m_spec.labels.empty() ? numClasses : m_spec.labels.size();
+
+        std::uniform_int_distribution<int32_t>  labelDist(0, numLabels - 1);
+
+        memset(tensor->data, 0, tensor->size);
+
+        for (int64_t r = 0; r < numRows; r++)
+        {
+            int64_t base = r * rowSize;
+            float   x1 = dist(m_rng) * 0.8f;
+            float   y1 = dist(m_rng) * 0.8f;
+            float   x2 = x1 + (1.0f - x1) * dist(m_rng);
+            float   y2 = y1 + (1.0f - y1) * dist(m_rng);
+            int32_t label = labelDist(m_rng);
+
+            if (!m_spec.labels.empty())
+            {
+                label = m_spec.labels[label];
+            }
+
+            setValue(tensor, base + f[0], x1 * m_width);
+            setValue(tensor, base + f[1], y1 * m_height);
+            setValue(tensor, base + f[2], x2 * m_width);
+            setValue(tensor, base + f[3], y2 * m_height);
+            setValue(tensor, base + f[4], label);
+            setValue(tensor, base + f[5], dist(m_rng));
+        }
+    }
+    else if ((fill == "echo") && (echo != nullptr) && (echoSize > 0))
+    {
+        uint8_t    *dst = reinterpret_cast<uint8_t *>(tensor->data);
+
+        for (int64_t off = 0; off < tensor->size; off += echoSize)
+        {
+            memcpy(dst + off, echo, std::min(echoSize, tensor->size - off));
+        }
+    }
+    else
+    {
+        memset(tensor->data, 0, tensor->size);
+    }
+}
+
+int32_t NullInferer::run(const VecDlTensorPtr  &inputs,
+                         VecDlTensorPtr        &outputs)
+{
+    DlLatencyScope  latency(m_runStats);
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_TRACE_SCOPE("NullInferer::run");
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+
+    if (getConcurrency() == DlConcurrency_Serialized)
+    {
+        lock.lock();
+    }
+
+    auto    start = std::chrono::steady_clock::now();
+    float   delayMs = m_spec.latencyMs;
+
+    if (m_inputs.size() != inputs.size())
+    {
+        DL_INFER_LOG_ERROR("Number of inputs does not match.\n");
+        return -1;
+    }
+
+    if (m_outputs.size() != outputs.size())
+    {
+        DL_INFER_LOG_ERROR("Number of outputs does not match.\n");
+        return -1;
+    }
+
+    {
+        /* The random generator is shared by the calls. */
+        std::unique_lock<std::mutex> fillLock(m_fillMutex);
+        const void                  *echo = nullptr;
+        int64_t                      echoSize = 0;
+
+        if ((m_spec.fill == "echo") && !inputs.empty() &&
+            (inputs[0]->data != nullptr))
+        {
+            echo     = getPackedData(inputs[0], m_echoInput);
+            echoSize = inputs[0]->size;
+        }
+
+        for (uint32_t i = 0; i < m_outputs.size(); i++)
+        {
+            DlTensor   *info = outputs[i];
+
+            if ((info->data == nullptr) || (info->size < m_outputs[i].size))
+            {
+                DL_INFER_LOG_ERROR("Invalid output buffer [%d].\n", i);
+                return -1;
+            }
+
+            fillOutput(info, echo, echoSize);
+        }
+
+        if (m_spec.jitterMs > 0)
+        {
+            std::uniform_real_distribution<float> dist(-m_spec.jitterMs,
+                                                       m_spec.jitterMs);
+            delayMs += dist(m_rng);
+        }
+    }
+
+    /* The time spent filling the outputs counts towards the latency. */
+    if (delayMs > 0)
+    {
+        std::this_thread::sleep_until(start +
+            std::chrono::duration<float, std::milli>(delayMs));
+    }
+
+    return 0;
+}
+
+int32_t NullInferer::runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                              std::vector<VecDlTensorPtr>       &outputs)
+{
+    int64_t batchSize = inputs.size();
+
+    if (!m_dynamicBatch || (batchSize < 2))
+    {
+        return DLInferer::runBatch(inputs, outputs);
+    }
+
+    DlLatencyScope  latency(m_runStats);
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_TRACE_SCOPE("NullInferer::runBatch");
+
+    /* The batch buffers are shared by the calls. */
+    DL_INFER_GET_EXCL_ACCESS;
+    auto    start = std::chrono::steady_clock::now();
+    float   delayMs = m_spec.latencyMs;
+    int32_t status;
+
+    status = checkBatch(inputs, outputs, m_inputs.size(), m_outputs.size());
+
+    if (status < 0)
+    {
+        return status;
+    }
+
+    m_batchInputs.resize(m_inputs.size());
+
+    if (m_batchOutputs.empty())
+    {
+        for (const auto &info : m_outputs)
+        {
+            m_batchOutputs.push_back(info.cloneInfo());
+        }
+    }
+
+    for (uint32_t i = 0; i < m_inputs.size(); i++)
+    {
+        if (packBatch(inputs, i, m_batchInputs[i]) < 0)
+        {
+            return -1;
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> fillLock(m_fillMutex);
+
+        for (uint32_t i = 0; (status == 0) && (i < m_outputs.size()); i++)
+        {
+            DlTensor               &batch = m_batchOutputs[i];
+            std::vector<int64_t>    shape = m_outputs[i].shape;
+
+            shape[0] = batchSize;
+            batch.reshape(shape, *this);
+
+            if (batch.data == nullptr)
+            {
+                DL_INFER_LOG_ERROR("Allocation of the batch of output [%d] "
+                                   "failed.\n", i);
+                return -1;
+            }
+
+            fillOutput(&batch, m_batchInputs[0].data,
+                       inputs[0][0]->size * batchSize);
+
+            status = scatterBatch(batch.data, batch.shape, outputs, i);
+        }
+
+        if (m_spec.jitterMs > 0)
+        {
+            std::uniform_real_distribution<float> dist(-m_spec.jitterMs,
+                                                       m_spec.jitterMs);
+            delayMs += dist(m_rng);
+        }
+    }
+
+    if ((status == 0) && (delayMs > 0))
+    {
+        std::this_thread::sleep_until(start +
+            std::chrono::duration<float, std::milli>(delayMs));
+    }
+
+    return status;
+}
+
+DlConcurrency NullInferer::getConcurrency()
+{
+    return m_spec.concurrent ? DlConcurrency_Concurrent :
+                               DlConcurrency_Serialized;
+}
+
+void NullInferer::dumpInfo()
+{
+    DL_INFER_LOG_INFO("Latency (ms)      = %f\n", m_spec.latencyMs);
+    DL_INFER_LOG_INFO("Concurrent        = %d\n", m_spec.concurrent);
+    DL_INFER_LOG_INFO("Jitter (ms)       = %f\n", m_spec.jitterMs);
+    DL_INFER_LOG_INFO("Output fill       = %s\n", m_spec.fill.c_str());
+    DL_INFER_LOG_INFO("Weights (bytes)   = %ld\n", m_spec.weightsBytes);
+    DL_INFER_LOG_INFO("Number of Inputs  = %d\n", (int32_t)m_inputs.size());
+
+    for (uint32_t i = 0; i < m_inputs.size(); i++)
+    {
+        DL_INFER_LOG_INFO("INPUT [%d]: \n", i);
+        m_inputs[i].dumpInfo();
+    }
+
+    DL_INFER_LOG_INFO("Number of Outputs  = %d\n", (int32_t)m_outputs.size());
+
+    for (uint32_t i = 0; i < m_outputs.size(); i++)
+    {
+        DL_INFER_LOG_INFO("OUTPUT [%d]: \n", i);
+        m_outputs[i].dumpInfo();
+    }
+}
+
+const VecDlTensor *NullInferer::getInputInfo()
+{
+    return &m_inputs;
+}
+
+const VecDlTensor *NullInferer::getOutputInfo()
+{
+    return &m_outputs;
+}
+
+NullInferer::~NullInferer()
+{
+    DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
+
+    /* Drain any pending asynchronous requests. */
+    stopAsync();
+}
+
+} // namespace ti::dl_inferer
@@ -61,8 +61,11 @@
  */
 /* Standard headers. */
 #include <stdio.h>
+#include <unistd.h>
 #include <cstring>
 #include <string>
+#include <fstream>
+#include <filesystem>
 #include <algorithm>
 
 /* Third-party headers. */
@@ -70,6 +73,7 @@
 
 /* Module headers. */
 #include <ti_onnx_inferer.h>
+#include <ti_dl_inferer_registry.h>
 #include <ti_dl_inferer_logger.h>
 
 using namespace ti::dl_inferer::utils;
@@ -131,7 +135,7 @@ int32_t Onnx2TiInferType(ONNXTensorElementDataType  type,
         case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
             tiType    = DlInferType_Float16;
             *typeName = "float16";
-            size      = sizeof(float);
+            size      = sizeof(uint16_t);
             break;
 
         case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
@@ -149,25 +153,82 @@ int32_t Onnx2TiInferType(ONNXTensorElementDataType  type,
     return size;
 }
 
+/* All the inferers of the process share a single environment. */
+static std::shared_ptr<Ort::Env> getSharedEnv()
+{
+    return DlModelRegistry::getInstance().getOrCreate<Ort::Env>("onnx:env", []()
+    {
+        return std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_ERROR, "ORTInferer");
+    });
+}
+
 ORTInferer::ORTInferer(const std::string &modelPath,
                        const std::string &artifactPath,
-                       bool               enableTidl):
+                       bool               enableTidl,
+                       bool               enableModelCache,
+                       const CpuTuning   &cpuTuning,
+                       bool               shareModel):
     m_modelPath(modelPath),
     m_artifactPath(artifactPath),
     m_enableTidl(enableTidl),
-    m_env(ORT_LOGGING_LEVEL_ERROR, __FUNCTION__),
+    m_enableModelCache(enableModelCache),
+    m_env(getSharedEnv()),
     m_memInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault))
 {
     OrtStatus              *ortStatus;
     Ort::SessionOptions     sessionOpts;
     c_api_tidl_options      tidlOpts{};
+    std::string             sessionModel = m_modelPath;
+    std::string             cacheFile;
+    std::string             tmpFile;
+    std::string             optStr;
+    int32_t                 intraThreads;
     int32_t                 status;
 
-    sessionOpts.SetIntraOpNumThreads(1);
+    intraThreads = cpuTuning.intraOpThreads > 0 ? cpuTuning.intraOpThreads : 1;
+    sessionOpts.SetIntraOpNumThreads(intraThreads);
+    optStr = "opt=extended;intra=" + std::to_string(intraThreads);
+
+    if (cpuTuning.parallelExecution)
+    {
+        sessionOpts.SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+
+        if (cpuTuning.interOpThreads > 0)
+        {
+            sessionOpts.SetInterOpNumThreads(cpuTuning.interOpThreads);
+        }
+
+        optStr += ";inter=" + std::to_string(cpuTuning.interOpThreads);
+    }
 
     sessionOpts.SetGraphOptimizationLevel(
             GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
 
+    /* The graph partitioned for TIDL cannot be serialized and hence the
+     * cache is only used when running on ARM.
+     */
+    if (m_enableModelCache && !m_enableTidl)
+    {
+        cacheFile = getModelCachePath(optStr);
+    }
+
+    if (!cacheFile.empty() && std::filesystem::exists(cacheFile))
+    {
+        DL_INFER_LOG_INFO("Loading optimized model [%s].\n", cacheFile.c_str());
+
+        sessionModel = cacheFile;
+        sessionOpts.SetGraphOptimizationLevel(
+                GraphOptimizationLevel::ORT_DISABLE_ALL);
+    }
+    else if (!cacheFile.empty())
+    {
+        /* Save to a temporary file first so that an interrupted start does
+         * not leave a truncated entry behind.
+         */
+        tmpFile = cacheFile + ".tmp" + std::to_string(getpid());
+        sessionOpts.SetOptimizedModelFilePath(tmpFile.c_str());
+    }
+
     if (m_enableTidl)
     {
         strcpy(tidlOpts.artifacts_folder, m_artifactPath.c_str());
@@ -179,9 +240,66 @@ ORTInferer::ORTInferer(const std::string &modelPath,
         ortStatus = NULL;
     }
 
+    /* The session keeps the environment alive until it is destroyed. */
+    auto createSession = [&]()
+    {
+        auto            env = m_env;
+        Ort::Session   *session;
+
+        try
+        {
+            session = new Ort::Session(*env, sessionModel.c_str(), sessionOpts);
+        }
+        catch (const Ort::Exception &e)
+        {
+            if (sessionModel == m_modelPath)
+            {
+                throw;
+            }
+
+            /* Drop a stale or corrupt entry and optimize the model again. */
+            DL_INFER_LOG_WARN("Loading optimized model failed [%s].\n", e.what());
+            std::filesystem::remove(cacheFile);
+
+            sessionOpts.SetGraphOptimizationLevel(
+                    GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+            session = new Ort::Session(*env, m_modelPath.c_str(), sessionOpts);
+        }
+
+        if (!tmpFile.empty())
+        {
+            std::error_code ec;
+
+            std::filesystem::rename(tmpFile, cacheFile, ec);
+
+            if (ec)
+            {
+                DL_INFER_LOG_WARN("Saving optimized model [%s] failed.\n",
+                                  cacheFile.c_str());
+                std::filesystem::remove(tmpFile, ec);
+            }
+        }
+
+        return std::shared_ptr<Ort::Session>(session,
+                                             [env](Ort::Session *s){ delete s; });
+    };
+
     if (ortStatus == NULL)
     {
-        m_session = new Ort::Session(m_env, m_modelPath.c_str(), sessionOpts);
+        /* Whether concurrent runs are safe with the TIDL execution provider
+         * is not specified, hence only the ARM sessions are shared.
+         */
+        if (shareModel && !m_enableTidl)
+        {
+            m_session = DlModelRegistry::getInstance().
+                            getOrCreate<Ort::Session>("onnx:" + m_modelPath +
+                                                      ":" + optStr,
+                                                      createSession);
+        }
+        else
+        {
+            m_session = createSession();
+        }
 
         // Query the input information
         status = populateInputInfo();
@@ -198,6 +316,15 @@ ORTInferer::ORTInferer(const std::string &modelPath,
         status = populateOutputInfo();
     }
 
+    if (status == 0)
+    {
+        m_boundShapes.resize(m_numInputs);
+        m_boundOutputShapes.resize(m_numOutputs);
+        m_lastShapes.resize(m_numOutputs);
+        m_shapeStable.assign(m_numOutputs, 0);
+        m_bindingSupported = createBinding() == 0;
+    }
+
     if (status < 0)
     {
         throw std::runtime_error("ORTInferer object creation failed.");
@@ -206,6 +333,97 @@ ORTInferer::ORTInferer(const std::string &modelPath,
     DL_INFER_LOG_DEBUG("CONSTRUCTOR\n");
 }
 
+std::string ORTInferer::getModelCachePath(const std::string &options)
+{
+    std::ifstream           model(m_modelPath, std::ios::binary);
+    std::filesystem::path   dir(m_artifactPath);
+    std::string             key;
+    std::vector<char>       buf(1 << 20);
+    uint64_t                hash = 0xcbf29ce484222325ull;
+    char                    hex[17];
+
+    if (!model)
+    {
+        DL_INFER_LOG_WARN("Cannot read [%s].\n", m_modelPath.c_str());
+        return std::string();
+    }
+
+    /* FNV-1a over the model, the runtime version and the options. */
+    while (model)
+    {
+        model.read(buf.data(), buf.size());
+
+        for (std::streamsize i = 0; i < model.gcount(); i++)
+        {
+            hash = (hash ^ static_cast<uint8_t>(buf[i])) * 0x100000001b3ull;
+        }
+    }
+
+    key = std::string(OrtGetApiBase()->GetVersionString()) + ";" + options;
+
+    for (const char c : key)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+    }
+
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+
+    /* Keep the entry next to the artifacts, or next to the model when the
+     * artifacts directory is not there.
+     */
+    if (m_artifactPath.empty() || !std::filesystem::is_directory(dir))
+    {
+        dir = std::filesystem::path(m_modelPath).parent_path();
+    }
+
+    if (access(dir.c_str(), W_OK) != 0)
+    {
+        DL_INFER_LOG_WARN("Optimized model cache disabled, [%s] is not "
+                          "writable.\n", dir.c_str());
+        return std::string();
+    }
+
+    return (dir / (std::filesystem::path(m_modelPath).stem().string() +
+                   "_" + hex + ".opt.onnx")).string();
+}
+
+int32_t ORTInferer::createBinding()
+{
+    /* Outputs start bound to runtime allocated memory until run() provides
+     * buffers that fit them.
+     */
+    try
+    {
+        m_binding = std::make_unique<Ort::IoBinding>(*m_session);
+
+        for (uint32_t i = 0; i < m_numOutputs; i++)
+        {
+            m_binding->BindOutput(m_outputNames[i], m_memInfo);
+        }
+    }
+    catch (const Ort::Exception &e)
+    {
+        DL_INFER_LOG_WARN("IoBinding not available [%s].\n", e.what());
+        m_binding.reset();
+        return -1;
+    }
+
+    m_boundInputs.assign(m_numInputs, nullptr);
+    m_boundOutputs.assign(m_numOutputs, nullptr);
+
+    for (auto &shape : m_boundShapes)
+    {
+        shape.clear();
+    }
+
+    for (auto &shape : m_boundOutputShapes)
+    {
+        shape.clear();
+    }
+
+    return 0;
+}
+
 int32_t ORTInferer::populateInputInfo()
 {
     int32_t numInfo;
@@ -216,9 +434,12 @@ int32_t ORTInferer::populateInputInfo()
     m_numInputs = numInfo;
 
     /* Reserve the storage. */
-    m_inputs.assign(numInfo, DlTensor());
+    m_inputs.clear();
+    m_inputs.resize(numInfo);
+    m_packedInputs.resize(numInfo);
     m_inputTypes.assign(numInfo, ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED);
     m_inputNames.assign(numInfo, nullptr);
+    m_dynamicBatch = numInfo > 0;
 
     for (int32_t i = 0; i < numInfo; i++)
     {
@@ -248,6 +469,34 @@ int32_t ORTInferer::populateInputInfo()
         info->dim     = tensorInfo.GetDimensionsCount();
         info->numElem = tensorInfo.GetElementCount();
 
+        /* A dynamic leading dimension is the batch size. Describe a single
+         * frame and let runBatch() pack the frames along this dimension.
+         * This only holds if the other dimensions are static, otherwise
+         * the shape is left unknown until the caller sets it.
+         */
+        if ((info->dim > 0) && (info->shape[0] < 0) &&
+            std::all_of(info->shape.begin() + 1, info->shape.end(),
+                        [](int64_t d){ return d >= 0; }))
+        {
+            info->shape[0] = 1;
+            info->numElem  = 1;
+
+            for (const auto d : info->shape)
+            {
+                info->numElem *= d;
+            }
+        }
+        else
+        {
+            m_dynamicBatch = false;
+
+            if (std::any_of(info->shape.begin(), info->shape.end(),
+                            [](int64_t d){ return d < 0; }))
+            {
+                info->numElem = -1;
+            }
+        }
+
         /* Get the type, type name, and size. */
         m_inputTypes[i] = tensorInfo.GetElementType();
 
@@ -279,7 +528,8 @@ int32_t ORTInferer::populateOutputInfo()
     m_numOutputs = numInfo;
 
     /* Reserve the storage. */
-    m_outputs.assign(numInfo, DlTensor());
+    m_outputs.clear();
+    m_outputs.resize(numInfo);
     m_outputTypes.assign(numInfo, ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED);
     m_outputNames.assign(numInfo, nullptr);
 
@@ -326,45 +576,329 @@ int32_t ORTInferer::populateOutputInfo()
 int32_t ORTInferer::run(const VecDlTensorPtr &inputs,
                         VecDlTensorPtr       &outputs)
 {
-    DL_INFER_GET_EXCL_ACCESS;
-    //auto null_outs = std::find_if(m_outputs.begin(), m_outputs.end(), [](auto t) { return t.size < 0; });
-    //auto null_ins = std::find_if(m_inputs.begin(), m_inputs.end(), [](auto t) { return t.size < 0; });
+    DlLatencyScope  latency(m_runStats);
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_TRACE_SCOPE("ORTInferer::run");
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
 
-    /*if(null_outs == m_outputs.end() && null_ins == m_inputs.end())
+    if ((m_numInputs != inputs.size()) || (m_numOutputs != outputs.size()))
+    {
+        DL_INFER_LOG_ERROR("Number of inputs or outputs does not match.\n");
+        return -1;
+    }
+
+    /* The persistent binding and the staging buffers belong to the call
+     * holding the instance. The overlapping calls bind their own buffers.
+     */
+    if (!lock.owns_lock())
+    {
+        if (getConcurrency() == DlConcurrency_Concurrent)
+        {
+            return run_concurrent(inputs, outputs);
+        }
+
+        lock.lock();
+    }
+
+    /* Rebuild the binding dropped by a failed run. */
+    if ((m_binding == nullptr) && m_bindingSupported)
+    {
+        createBinding();
+    }
+
+    if (m_binding != nullptr)
     {
         return run_zerocopy(inputs, outputs);
     }
-    else*/
+
+    return run_memcopy(inputs, outputs);
+}
+
+void ORTInferer::updateOutputShape(uint32_t index, const DlTensor *info)
+{
+    if (m_outputs[index].size > 0)
     {
-        return run_memcopy(inputs, outputs);
+        return;
     }
 
+    /* The vectors keep their storage, this does not allocate once the
+     * largest rank has been seen.
+     */
+    m_shapeStable[index] = (info->shape == m_lastShapes[index]);
+    m_lastShapes[index]  = info->shape;
+}
+
+void ORTInferer::copyOutput(Ort::Value            &tensor,
+                            DlTensor              *info,
+                            std::vector<int64_t>  &shape)
+{
+    const void     *src = tensor.GetTensorMutableData<void>();
+    const auto     &tsInfo = tensor.GetTensorTypeAndShapeInfo();
+
+    shape.resize(tsInfo.GetDimensionsCount());
+    tsInfo.GetDimensions(shape.data(), shape.size());
+
+    /* Grow the buffer if the output does not fit. This is typically the
+     * case for the detection models where the actual tensor output
+     * dimensions are not known until one inference is run.
+     */
+    info->reshape(shape, *this);
+
+    memcpy(info->data, src, info->size);
+}
+
+void ORTInferer::setInputValues(const VecDlTensorPtr &inputs,
+                                RunScratch           &scratch)
+{
+    /* Sized on the first run using the storage. */
+    while (scratch.inputValues.size() < m_numInputs)
+    {
+        scratch.inputValues.emplace_back(nullptr);
+    }
+
+    while (scratch.outputValues.size() < m_numOutputs)
+    {
+        scratch.outputValues.emplace_back(nullptr);
+    }
+
+    scratch.inputData.resize(m_numInputs, nullptr);
+    scratch.inputShapes.resize(m_numInputs);
+    scratch.outputData.resize(m_numOutputs, nullptr);
+    scratch.inPlace.resize(m_numOutputs, 0);
+    scratch.staging.resize(m_numInputs);
+
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        const DlTensor *info = inputs[i];
+        void           *data = getPackedData(info, scratch.staging[i]);
+
+        /* Creating a value allocates, reuse the one of the last run when
+         * it refers to the same buffer.
+         */
+        if ((data != scratch.inputData[i]) ||
+            (info->shape != scratch.inputShapes[i]))
+        {
+            scratch.inputValues[i] =
+                Ort::Value::CreateTensor(m_memInfo,
+                                         data,
+                                         (size_t)info->size,
+                                         info->shape.data(),
+                                         info->shape.size(),
+                                         m_inputTypes[i]);
+
+            scratch.inputData[i]   = data;
+            scratch.inputShapes[i] = info->shape;
+        }
+    }
+}
+
+ORTInferer::RunScratch *ORTInferer::acquireScratch()
+{
+    std::lock_guard<std::mutex> lock(m_scratchMutex);
+    RunScratch                 *scratch;
+
+    if (m_freeScratch.empty())
+    {
+        /* More threads than ever before are running concurrently. */
+        m_scratch.push_back(std::make_unique<RunScratch>());
+        m_freeScratch.reserve(m_scratch.size());
+
+        return m_scratch.back().get();
+    }
+
+    scratch = m_freeScratch.back();
+    m_freeScratch.pop_back();
+
+    return scratch;
+}
+
+void ORTInferer::releaseScratch(RunScratch *scratch)
+{
+    std::lock_guard<std::mutex> lock(m_scratchMutex);
+
+    m_freeScratch.push_back(scratch);
 }
 
 int32_t ORTInferer::run_memcopy(const VecDlTensorPtr &inputs,
                                 VecDlTensorPtr       &outputs)
 {
+    RunScratch             &scratch = m_runScratch;
+    const Ort::RunOptions  &runOpts = m_runOpts;
+    int32_t                 status = 0;
+
+    setInputValues(inputs, scratch);
+
+    m_session->Run(runOpts,
+                   m_inputNames.data(),
+                   scratch.inputValues.data(),
+                   m_numInputs,
+                   m_outputNames.data(),
+                   scratch.outputValues.data(),
+                   m_numOutputs);
+
+    /* Copy the output buffers and release the runtime allocated ones. */
+    for (uint32_t i = 0; i < m_numOutputs; i++)
+    {
+        copyOutput(scratch.outputValues[i], outputs[i], scratch.shape);
+        updateOutputShape(i, outputs[i]);
+        scratch.outputValues[i] = Ort::Value(nullptr);
+    }
+
+    return status;
+}
+
+int32_t ORTInferer::run_concurrent(const VecDlTensorPtr &inputs,
+                                   VecDlTensorPtr       &outputs)
+{
+    DL_INFER_TRACE_SCOPE("ORTInferer::run_concurrent");
+    RunScratch             *scratch = acquireScratch();
+    const Ort::RunOptions  &runOpts = m_runOpts;
+
+    try
+    {
+        setInputValues(inputs, *scratch);
+
+        /* Write the outputs of a fixed shape in place and let the runtime
+         * allocate the others.
+         */
+        for (uint32_t i = 0; i < m_numOutputs; i++)
+        {
+            const DlTensor *model = &m_outputs[i];
+            DlTensor       *info = outputs[i];
+
+            if ((model->size > 0) && (info->size >= model->size))
+            {
+                if (!scratch->inPlace[i] ||
+                    (scratch->outputData[i] != info->data))
+                {
+                    scratch->outputValues[i] =
+                        Ort::Value::CreateTensor(m_memInfo,
+                                                 info->data,
+                                                 (size_t)model->size,
+                                                 model->shape.data(),
+                                                 model->shape.size(),
+                                                 m_outputTypes[i]);
+
+                    scratch->outputData[i] = info->data;
+                    scratch->inPlace[i]    = 1;
+                }
+            }
+            else
+            {
+                scratch->outputValues[i] = Ort::Value(nullptr);
+                scratch->inPlace[i]      = 0;
+            }
+        }
+
+        try
+        {
+            m_session->Run(runOpts,
+                           m_inputNames.data(),
+                           scratch->inputValues.data(),
+                           m_numInputs,
+                           m_outputNames.data(),
+                           scratch->outputValues.data(),
+                           m_numOutputs);
+        }
+        catch (const Ort::Exception &e)
+        {
+            /* An output whose actual shape differs from the one declared
+             * by the model. Retry letting the runtime allocate all the
+             * outputs.
+             */
+            DL_INFER_LOG_DEBUG("In-place run failed [%s], copying the "
+                               "outputs.\n", e.what());
+
+            for (uint32_t i = 0; i < m_numOutputs; i++)
+            {
+                scratch->outputValues[i] = Ort::Value(nullptr);
+                scratch->inPlace[i]      = 0;
+            }
+
+            m_session->Run(runOpts,
+                           m_inputNames.data(),
+                           scratch->inputValues.data(),
+                           m_numInputs,
+                           m_outputNames.data(),
+                           scratch->outputValues.data(),
+                           m_numOutputs);
+        }
+
+        for (uint32_t i = 0; i < m_numOutputs; i++)
+        {
+            if (!scratch->inPlace[i])
+            {
+                copyOutput(scratch->outputValues[i], outputs[i], scratch->shape);
+                scratch->outputValues[i] = Ort::Value(nullptr);
+            }
+        }
+    }
+    catch (...)
+    {
+        releaseScratch(scratch);
+        throw;
+    }
+
+    releaseScratch(scratch);
+
+    return 0;
+}
+
+int32_t ORTInferer::runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                             std::vector<VecDlTensorPtr>       &outputs)
+{
+    int64_t batchSize = inputs.size();
+
+    if (!m_dynamicBatch || (batchSize < 2))
+    {
+        return DLInferer::runBatch(inputs, outputs);
+    }
+
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_GET_EXCL_ACCESS;
     std::vector<Ort::Value> inputValues;
     std::vector<Ort::Value> outputValues;
-    const Ort::RunOptions  &runOpts = Ort::RunOptions();
-    int32_t                 status = 0;
+    const Ort::RunOptions  &runOpts = m_runOpts;
+    int32_t                 status;
+
+    status = checkBatch(inputs, outputs, m_numInputs, m_numOutputs);
+
+    if (status < 0)
+    {
+        return status;
+    }
+
+    m_batchInputs.resize(m_numInputs);
 
+    /* Pack the frames along the leading dimension. */
     for (uint32_t i = 0; i < m_numInputs; i++)
     {
-        const DlTensor *info = inputs[i];
+        const DlTensor *info = inputs[0][i];
+        DlTensor       &packed = m_batchInputs[i];
+
+        status = packBatch(inputs, i, packed);
+
+        if (status < 0)
+        {
+            break;
+        }
+
+        std::vector<int64_t> shape = info->shape;
+        shape[0] = batchSize;
+
         Ort::Value v = Ort::Value::CreateTensor(m_memInfo,
-                                                (void *)info->data,
-                                                (size_t)info->size,
-                                                info->shape.data(),
-                                                info->shape.size(),
+                                                packed.data,
+                                                (size_t)(info->size * batchSize),
+                                                shape.data(),
+                                                shape.size(),
                                                 m_inputTypes[i]);
 
         inputValues.push_back(std::move(v));
     }
 
-    for (uint32_t i = 0; i < m_numOutputs; i++)
+    if (status < 0)
     {
-        outputValues.emplace_back(nullptr);
+        return status;
     }
 
     outputValues = m_session->Run(runOpts,
@@ -374,72 +908,150 @@ int32_t ORTInferer::run_memcopy(const VecDlTensorPtr &inputs,
                                   m_outputNames.data(),
                                   m_numOutputs);
 
-    /* Copy the output buffers. */
-    for (uint32_t i = 0; i < m_numOutputs; i++)
+    /* Scatter the outputs back to the frames. */
+    for (uint32_t i = 0; (status == 0) && (i < m_numOutputs); i++)
     {
-        DlTensor       *info = outputs[i];
         auto           &tensor = outputValues[i];
-        void           *src = tensor.GetTensorMutableData<void>();
         const auto     &tsInfo = tensor.GetTensorTypeAndShapeInfo();
-        int32_t         newSize;
 
-        /* Update the output tensor object details. */
-        info->shape   = tsInfo.GetShape();
-        info->dim     = tsInfo.GetDimensionsCount();
-        info->numElem = tsInfo.GetElementCount();
-        newSize       = info->numElem * info->elemSize;
+        status = scatterBatch(tensor.GetTensorMutableData<uint8_t>(),
+                              tsInfo.GetShape(), outputs, i);
+    }
+
+    return status;
+}
 
-        /* Allocate new buffers if the new size is not the same as the old one.
-         * This is typically the case for the detection models where the actual
-         * tensor output dimensions are not known until one inference is run.
+int32_t ORTInferer::bindBuffers(const VecDlTensorPtr &inputs,
+                                VecDlTensorPtr       &outputs)
+{
+    if (m_binding == nullptr)
+    {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        const DlTensor *info = inputs[i];
+        void           *data = getPackedData(info, m_packedInputs[i]);
+
+        /* The shape of an input changes with the call for the models with
+         * dynamic dimensions.
          */
-        if (newSize != info->size)
+        if ((data != m_boundInputs[i]) || (info->shape != m_boundShapes[i]))
+        {
+            Ort::Value v = Ort::Value::CreateTensor(m_memInfo,
+                                                    data,
+                                                    (size_t)info->size,
+                                                    info->shape.data(),
+                                                    info->shape.size(),
+                                                    m_inputTypes[i]);
+
+            m_binding->BindInput(m_inputNames[i], v);
+            m_boundInputs[i] = data;
+            m_boundShapes[i] = info->shape;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_numOutputs; i++)
+    {
+        const DlTensor                 *model = &m_outputs[i];
+        DlTensor                       *info = outputs[i];
+        const std::vector<int64_t>     *shape = nullptr;
+        int64_t                         size = 0;
+
+        if (model->size > 0)
+        {
+            if (info->size >= model->size)
+            {
+                shape = &model->shape;
+                size  = model->size;
+            }
+        }
+        else if (m_shapeStable[i])
         {
-            DL_INFER_LOG_DEBUG("NEW_SIZE = %d OLD_SIZE = %d\n",
-                               newSize, info->size);
-            info->size = newSize;
-            info->allocateDataBuffer(*this);
+            /* Expect the shape of the last runs. The buffer only grows,
+             * hence this stops allocating once the largest shape is seen.
+             */
+            info->reshape(m_lastShapes[i], *this);
+
+            if (info->data != nullptr)
+            {
+                shape = &m_lastShapes[i];
+                size  = info->size;
+            }
         }
 
-        memcpy(info->data, src, info->size);
+        if (shape != nullptr)
+        {
+            if ((info->data != m_boundOutputs[i]) ||
+                (*shape != m_boundOutputShapes[i]))
+            {
+                Ort::Value v = Ort::Value::CreateTensor(m_memInfo,
+                                                        info->data,
+                                                        (size_t)size,
+                                                        shape->data(),
+                                                        shape->size(),
+                                                        m_outputTypes[i]);
+
+                m_binding->BindOutput(m_outputNames[i], v);
+                m_boundOutputs[i]      = info->data;
+                m_boundOutputShapes[i] = *shape;
+            }
+        }
+        else if (m_boundOutputs[i] != nullptr)
+        {
+            m_binding->BindOutput(m_outputNames[i], m_memInfo);
+            m_boundOutputs[i] = nullptr;
+        }
     }
 
-    return status;
+    return 0;
 }
 
 int32_t ORTInferer::run_zerocopy(const VecDlTensorPtr &inputs,
                                  VecDlTensorPtr       &outputs)
 {
-    Ort::IoBinding binding(*m_session);
-    const Ort::RunOptions  &runOpts = Ort::RunOptions();
+    const Ort::RunOptions  &runOpts = m_runOpts;
     int32_t                 status = 0;
 
-    for (uint32_t i = 0; i < m_numInputs; i++)
+    try
     {
-        const DlTensor *info = inputs[i];
-        Ort::Value v = Ort::Value::CreateTensor(m_memInfo,
-                                                (void *)info->data,
-                                                (size_t)info->size,
-                                                info->shape.data(),
-                                                info->shape.size(),
-                                                m_inputTypes[i]);
-        binding.BindInput(info->name, v);
+        bindBuffers(inputs, outputs);
+        m_session->Run(runOpts, *m_binding);
     }
-
-    for (uint32_t i = 0; i < m_numOutputs; i++)
+    catch (const Ort::Exception &e)
     {
-        const DlTensor *info = outputs[i];
-        Ort::Value v = Ort::Value::CreateTensor(m_memInfo,
-                                                (void *)info->data,
-                                                (size_t)info->size,
-                                                info->shape.data(),
-                                                info->shape.size(),
-                                                m_outputTypes[i]);
-        binding.BindOutput(info->name, v);
+        /* Typically an output whose shape changed since the last runs, or
+         * an invalid input. Copy the outputs of this call, which adapts to
+         * any shape, and bind again on the next one.
+         */
+        DL_INFER_LOG_WARN("Zero-copy run failed [%s], copying the outputs "
+                          "of this run.\n", e.what());
+        m_binding.reset();
+        std::fill(m_shapeStable.begin(), m_shapeStable.end(), 0);
+
+        return run_memcopy(inputs, outputs);
     }
 
+    /* Only a run with outputs bound to runtime allocated memory gets the
+     * values, which allocates. Once the shapes are stable and the buffers
+     * have grown, all the outputs are bound in place.
+     */
+    if (std::find(m_boundOutputs.begin(), m_boundOutputs.end(), nullptr) !=
+        m_boundOutputs.end())
+    {
+        std::vector<Ort::Value> outputValues = m_binding->GetOutputValues();
+
+        for (uint32_t i = 0; i < m_numOutputs; i++)
+        {
+            if (m_boundOutputs[i] == nullptr)
+            {
+                copyOutput(outputValues[i], outputs[i], m_shape);
+            }
 
-    m_session->Run(runOpts, binding);
+            updateOutputShape(i, outputs[i]);
+        }
+    }
 
     return status;
 }
@@ -469,6 +1081,12 @@ void ORTInferer::dumpInfo()
 
 }
 
+DlConcurrency ORTInferer::getConcurrency()
+{
+    /* The TIDL execution provider drives a single accelerator context. */
+    return m_enableTidl ? DlConcurrency_Serialized : DlConcurrency_Concurrent;
+}
+
 const VecDlTensor *ORTInferer::getInputInfo()
 {
     return &m_inputs;
@@ -483,6 +1101,12 @@ ORTInferer::~ORTInferer()
 {
     DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
 
+    /* Drain any pending asynchronous requests. */
+    stopAsync();
+
+    /* The binding refers to the session. */
+    m_binding.reset();
+
     /* Releast the memory allocated for the strings. */
     for (const auto &vec : {m_inputNames, m_outputNames})
     {
@@ -492,19 +1116,7 @@ ORTInferer::~ORTInferer()
         }
     }
 
-    delete m_session;
-}
-
-void *ORTInferer::allocate(int64_t size)
-{
-    void *mem = NULL;
-
-    if(size > 0)
-    {
-        mem = new uint8_t[size];
-    }
-
-    return mem;
+    m_session.reset();
 }
 
 } // namespace ti::dl_inferer
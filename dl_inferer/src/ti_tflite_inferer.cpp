@@ -62,6 +62,8 @@
 /* Standard headers. */
 #include <stdio.h>
 #include <dlfcn.h>
+#include <cstring>
+#include <algorithm>
 
 /* Third-party headers. */
 #include <tensorflow/lite/c/common.h>
@@ -70,6 +72,7 @@
 
 /* Module headers. */
 #include <ti_tflite_inferer.h>
+#include <ti_dl_inferer_registry.h>
 #include <ti_dl_inferer_logger.h>
 
 using namespace ti::dl_inferer::utils;
@@ -124,12 +127,50 @@ DlInferType Tflite2TiInferType(TfLiteType type)
     return tiType;
 }
 
+static void getQuantParams(const TfLiteTensor   *tensor,
+                           DlQuantParams        &quant)
+{
+    quant = DlQuantParams();
+
+    if (tensor->quantization.type == kTfLiteAffineQuantization)
+    {
+        const auto *q = reinterpret_cast<const TfLiteAffineQuantization *>
+                            (tensor->quantization.params);
+
+        if ((q != nullptr) && (q->scale != nullptr) && (q->zero_point != nullptr))
+        {
+            for (int32_t i = 0; i < q->scale->size; i++)
+            {
+                quant.scale.push_back(q->scale->data[i]);
+
+                /* Symmetric per-channel tensors may list a single zero point. */
+                quant.zeroPoint.push_back(q->zero_point->data[
+                                          i < q->zero_point->size ? i : 0]);
+            }
+
+            quant.axis = q->quantized_dimension;
+        }
+    }
+
+    /* Older models only carry the per-tensor parameters. */
+    if (quant.scale.empty() && (tensor->params.scale != 0.0f))
+    {
+        quant.scale.push_back(tensor->params.scale);
+        quant.zeroPoint.push_back(tensor->params.zero_point);
+    }
+}
+
 TFLiteInferer::TFLiteInferer(const std::string &modelPath,
                              const std::string &artifactPath,
-                             bool               enableTidl):
+                             bool               enableTidl,
+                             const CpuTuning   &cpuTuning,
+                             int32_t            shapeCacheSize,
+                             bool               shareModel):
     m_modelPath(modelPath),
     m_artifactPath(artifactPath),
-    m_enableTidl(enableTidl)
+    m_enableTidl(enableTidl),
+    m_numThreads(cpuTuning.intraOpThreads),
+    m_shapeCacheSize(std::max(shapeCacheSize, 1))
 {
     Create_delegate     createPlugin;
     const char         *keys[2];
@@ -140,7 +181,26 @@ TFLiteInferer::TFLiteInferer(const std::string &modelPath,
     size_t              numOptions = 0;
     int32_t             status = 0;
 
-    m_model = tflite::FlatBufferModel::BuildFromFile(m_modelPath.c_str());
+    auto buildModel = [this]()
+    {
+        return std::shared_ptr<tflite::FlatBufferModel>(
+                   tflite::FlatBufferModel::BuildFromFile(m_modelPath.c_str()));
+    };
+
+    /* The interpreters only read the model, hence the instances of the
+     * same model can build theirs from a single copy.
+     */
+    if (shareModel)
+    {
+        m_model = DlModelRegistry::getInstance().
+                      getOrCreate<tflite::FlatBufferModel>("tflite:" + m_modelPath,
+                                                           buildModel);
+    }
+    else
+    {
+        m_model = buildModel();
+    }
+
     if (m_model == nullptr)
     {
         DL_INFER_LOG_ERROR("Model build failed.\n");
@@ -157,6 +217,18 @@ TFLiteInferer::TFLiteInferer(const std::string &modelPath,
         }
     }
 
+    /* The thread count applies to the operators added after this, hence
+     * set it before the delegate and the tensor allocation.
+     */
+    if ((status == 0) && (cpuTuning.intraOpThreads > 0))
+    {
+        if (m_interpreter->SetNumThreads(cpuTuning.intraOpThreads) != kTfLiteOk)
+        {
+            DL_INFER_LOG_WARN("Setting %d threads failed.\n",
+                              cpuTuning.intraOpThreads);
+        }
+    }
+
     if (m_enableTidl)
     {
         // Setup delegate
@@ -239,7 +311,11 @@ int32_t TFLiteInferer::populateInputInfo()
     m_numInputs = inputs.size();
 
     // Reserve the storage
-    m_inputs.assign(m_numInputs, DlTensor());
+    m_inputs.clear();
+    m_inputs.resize(m_numInputs);
+    m_packedInputs.resize(m_numInputs);
+    m_shapeKey.clear();
+    m_dynamicBatch = m_numInputs > 0;
 
     for (uint32_t i = 0; i < m_numInputs; i++)
     {
@@ -268,6 +344,35 @@ int32_t TFLiteInferer::populateInputInfo()
 
         info->elemSize = info->size/info->numElem;
 
+        getQuantParams(tensor, info->quant);
+
+        m_shapeKey.insert(m_shapeKey.end(), info->shape.begin(), info->shape.end());
+
+        /* The leading dimension is the batch size if it is dynamic in the
+         * model signature.
+         */
+        if ((tensor->dims_signature == nullptr) ||
+            (tensor->dims_signature->size == 0) ||
+            (tensor->dims_signature->data[0] != -1))
+        {
+            m_dynamicBatch = false;
+        }
+
+        /* The other dynamic dimensions are set per run by the caller and
+         * are reported as unknown.
+         */
+        for (int32_t j = 1; (tensor->dims_signature != nullptr) &&
+                            (j < tensor->dims_signature->size); j++)
+        {
+            if (tensor->dims_signature->data[j] == -1)
+            {
+                info->shape[j] = -1;
+                info->numElem  = -1;
+                info->size     = -info->elemSize;
+                m_dynamicShape = true;
+            }
+        }
+
     } // for (uint32_t i = 0; i < m_numInputs; i++)
 
     return 0;
@@ -280,7 +385,8 @@ int32_t TFLiteInferer::populateOutputInfo()
     m_numOutputs = outputs.size();
 
     // Reserve the storage
-    m_outputs.assign(m_numOutputs, DlTensor());
+    m_outputs.clear();
+    m_outputs.resize(m_numOutputs);
 
     for (uint32_t i = 0; i < m_numOutputs; i++)
     {
@@ -309,6 +415,21 @@ int32_t TFLiteInferer::populateOutputInfo()
 
         info->elemSize = info->size/info->numElem;
 
+        getQuantParams(tensor, info->quant);
+
+        /* The shape of the outputs follows the one of the inputs. */
+        for (int32_t j = 1; m_dynamicShape &&
+                            (tensor->dims_signature != nullptr) &&
+                            (j < tensor->dims_signature->size); j++)
+        {
+            if (tensor->dims_signature->data[j] == -1)
+            {
+                info->shape[j] = -1;
+                info->numElem  = -1;
+                info->size     = -info->elemSize;
+            }
+        }
+
     } // for (uint32_t i = 0; i < m_numOutputs; i++)
 
     return 0;
@@ -317,6 +438,9 @@ int32_t TFLiteInferer::populateOutputInfo()
 int32_t TFLiteInferer::run(const VecDlTensorPtr  &inputs,
                            VecDlTensorPtr        &outputs)
 {
+    DlLatencyScope  latency(m_runStats);
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_TRACE_SCOPE("TFLiteInferer::run");
     DL_INFER_GET_EXCL_ACCESS;
     TfLiteStatus    tfStatus;
     int32_t         status = 0;
@@ -332,37 +456,343 @@ int32_t TFLiteInferer::run(const VecDlTensorPtr  &inputs,
         status = -1;
     }
 
+    if (status == 0)
+    {
+        status = selectShape(inputs);
+    }
+
+    if ((status == 0) && m_dynamicShape)
+    {
+        updateOutputs(outputs);
+    }
+
     /* Set inputs and outputs (zero-copy). */
     if (status == 0)
     {
-        for (uint32_t i = 0; i < m_numInputs; i++)
+        status = bindBuffers(inputs, outputs);
+    }
+
+    /* Run the model. */
+    if (status == 0)
+    {
+        tfStatus = m_interpreter->Invoke();
+
+        if (tfStatus != kTfLiteOk)
+        {
+            DL_INFER_LOG_ERROR("Invoke() failed.\n");
+            status = -1;
+        }
+    }
+
+    return status;
+}
+
+int32_t TFLiteInferer::bindBuffers(const VecDlTensorPtr  &inputs,
+                                   VecDlTensorPtr        &outputs)
+{
+    m_boundInputs.resize(m_numInputs, nullptr);
+    m_boundOutputs.resize(m_numOutputs, nullptr);
+
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        void   *data = getPackedData(inputs[i], m_packedInputs[i]);
+
+        if (data != m_boundInputs[i])
         {
-            int tensor_idx = m_interpreter->inputs()[i];
             const TfLiteTensor *tensor = m_interpreter->input_tensor(i);
-            m_interpreter->SetCustomAllocationForTensor(tensor_idx,
-                    {inputs[i]->data, TfLiteTensorByteSize(tensor)});
+
+            m_interpreter->SetCustomAllocationForTensor(m_interpreter->inputs()[i],
+                    {data, TfLiteTensorByteSize(tensor)});
+            m_boundInputs[i] = data;
         }
-        for (uint32_t i = 0; i < m_numOutputs; i++)
+    }
+
+    for (uint32_t i = 0; i < m_numOutputs; i++)
+    {
+        if (outputs[i]->data != m_boundOutputs[i])
         {
-            int tensor_idx = m_interpreter->outputs()[i];
             const TfLiteTensor *tensor = m_interpreter->output_tensor(i);
-            m_interpreter->SetCustomAllocationForTensor(tensor_idx,
+
+            m_interpreter->SetCustomAllocationForTensor(m_interpreter->outputs()[i],
                     {outputs[i]->data, TfLiteTensorByteSize(tensor)});
+            m_boundOutputs[i] = outputs[i]->data;
         }
     }
 
-    /* Run the model. */
-    if (status == 0)
+    return 0;
+}
+
+void TFLiteInferer::swapPlan(ShapePlan &plan)
+{
+    std::swap(m_shapeKey, plan.key);
+    std::swap(m_interpreter, plan.interpreter);
+    std::swap(m_boundInputs, plan.boundInputs);
+    std::swap(m_boundOutputs, plan.boundOutputs);
+}
+
+int32_t TFLiteInferer::selectShape(const VecDlTensorPtr &inputs)
+{
+    uint32_t    pos = 0;
+    bool        match = true;
+
+    if (!m_dynamicShape)
     {
-        tfStatus = m_interpreter->Invoke();
+        /* Restore the single frame shapes after a batched invocation. */
+        return (m_batchSize != 1) ? setBatchSize(1) : 0;
+    }
 
-        if (tfStatus != kTfLiteOk)
+    /* Compare against the active shapes without building a key. */
+    for (uint32_t i = 0; match && (i < m_numInputs); i++)
+    {
+        for (const auto d : inputs[i]->shape)
+        {
+            if ((pos >= m_shapeKey.size()) || (m_shapeKey[pos++] != d))
+            {
+                match = false;
+                break;
+            }
+        }
+    }
+
+    if (match && (pos == m_shapeKey.size()))
+    {
+        return 0;
+    }
+
+    m_shape.clear();
+
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        const auto &shape = inputs[i]->shape;
+
+        if (std::any_of(shape.begin(), shape.end(), [](int64_t d){ return d <= 0; }))
+        {
+            DL_INFER_LOG_ERROR("Input [%d] has no valid shape.\n", i);
+            return -1;
+        }
+
+        m_shape.insert(m_shape.end(), shape.begin(), shape.end());
+    }
+
+    for (auto it = m_shapePlans.begin(); it != m_shapePlans.end(); ++it)
+    {
+        if (it->key == m_shape)
+        {
+            swapPlan(*it);
+            m_shapePlans.splice(m_shapePlans.begin(), m_shapePlans, it);
+            return 0;
+        }
+    }
+
+    /* The delegate is bound to the interpreter it was created for, hence
+     * the TIDL offload re-plans the single interpreter in place.
+     */
+    if (!m_enableTidl && ((m_shapePlans.size() + 1) < m_shapeCacheSize))
+    {
+        std::unique_ptr<tflite::Interpreter>    interpreter;
+
+        tflite::InterpreterBuilder(*m_model, m_resolver)(&interpreter);
+
+        if (interpreter == nullptr)
+        {
+            DL_INFER_LOG_ERROR("Inferer construction failed.\n");
+            return -1;
+        }
+
+        if (m_numThreads > 0)
+        {
+            interpreter->SetNumThreads(m_numThreads);
+        }
+
+        m_shapePlans.emplace_front();
+        m_shapePlans.front().interpreter = std::move(interpreter);
+        swapPlan(m_shapePlans.front());
+    }
+    else if (!m_shapePlans.empty())
+    {
+        swapPlan(m_shapePlans.back());
+        m_shapePlans.splice(m_shapePlans.begin(), m_shapePlans,
+                            std::prev(m_shapePlans.end()));
+    }
+
+    DL_INFER_LOG_DEBUG("Planning for a new input shape.\n");
+
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        std::vector<int>    dims(inputs[i]->shape.begin(),
+                                 inputs[i]->shape.end());
+
+        if (m_interpreter->ResizeInputTensor(m_interpreter->inputs()[i],
+                                             dims) != kTfLiteOk)
+        {
+            DL_INFER_LOG_ERROR("ResizeInputTensor(%d) failed.\n", i);
+            m_shapeKey.clear();
+            return -1;
+        }
+    }
+
+    if (m_interpreter->AllocateTensors() != kTfLiteOk)
+    {
+        DL_INFER_LOG_ERROR("Tensor allocation failed.\n");
+        m_shapeKey.clear();
+        return -1;
+    }
+
+    m_shapeKey = m_shape;
+    m_boundInputs.assign(m_numInputs, nullptr);
+    m_boundOutputs.assign(m_numOutputs, nullptr);
+
+    return 0;
+}
+
+void TFLiteInferer::updateOutputs(VecDlTensorPtr &outputs)
+{
+    for (uint32_t i = 0; i < m_numOutputs; i++)
+    {
+        const TfLiteTensor *tensor = m_interpreter->output_tensor(i);
+        int32_t             dim = TfLiteTensorNumDims(tensor);
+
+        m_shape.resize(dim);
+
+        for (int32_t j = 0; j < dim; j++)
+        {
+            m_shape[j] = TfLiteTensorDim(tensor, j);
+        }
+
+        if ((outputs[i]->shape != m_shape) || (outputs[i]->data == nullptr))
+        {
+            outputs[i]->reshape(m_shape, *this);
+        }
+    }
+}
+
+int32_t TFLiteInferer::setBatchSize(int32_t batchSize)
+{
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        std::vector<int>    dims(m_inputs[i].shape.begin(),
+                                 m_inputs[i].shape.end());
+
+        dims[0] = batchSize;
+
+        if (m_interpreter->ResizeInputTensor(m_interpreter->inputs()[i],
+                                             dims) != kTfLiteOk)
+        {
+            DL_INFER_LOG_ERROR("ResizeInputTensor(%d) failed.\n", i);
+            return -1;
+        }
+    }
+
+    if (m_interpreter->AllocateTensors() != kTfLiteOk)
+    {
+        DL_INFER_LOG_ERROR("Tensor allocation failed.\n");
+        return -1;
+    }
+
+    m_batchSize = batchSize;
+
+    return 0;
+}
+
+int32_t TFLiteInferer::runBatch(const std::vector<VecDlTensorPtr> &inputs,
+                                std::vector<VecDlTensorPtr>       &outputs)
+{
+    int32_t batchSize = inputs.size();
+
+    /* The frames of a model with dynamic input dimensions may differ in
+     * shape and hence get run one by one.
+     */
+    if (!m_dynamicBatch || m_dynamicShape || (batchSize < 2))
+    {
+        return DLInferer::runBatch(inputs, outputs);
+    }
+
+    DlCpuAffinityScope  affinity(m_cpuAffinity);
+    DL_INFER_GET_EXCL_ACCESS;
+    int32_t status;
+
+    status = checkBatch(inputs, outputs, m_numInputs, m_numOutputs);
+
+    if (status < 0)
+    {
+        return status;
+    }
+
+    m_batchInputs.resize(m_numInputs);
+    m_batchOutputs.resize(m_numOutputs);
+
+    /* The batch staging buffers replace the bindings made by run(). */
+    std::fill(m_boundInputs.begin(), m_boundInputs.end(), nullptr);
+    std::fill(m_boundOutputs.begin(), m_boundOutputs.end(), nullptr);
+
+    /* Pack the frames along the leading dimension. The staging buffers are
+     * set as custom allocations before resizing since the tensors have to
+     * fit the custom allocations when they get re-allocated.
+     */
+    for (uint32_t i = 0; i < m_numInputs; i++)
+    {
+        DlTensor   &packed = m_batchInputs[i];
+
+        if (packBatch(inputs, i, packed) < 0)
+        {
+            return -1;
+        }
+
+        m_interpreter->SetCustomAllocationForTensor(m_interpreter->inputs()[i],
+                {packed.data, static_cast<size_t>(inputs[0][i]->size * batchSize)});
+    }
+
+    for (uint32_t i = 0; i < m_numOutputs; i++)
+    {
+        DlTensor   &packed = m_batchOutputs[i];
+        int64_t     frameSize = m_outputs[i].size;
+
+        if (packed.size < (frameSize * batchSize))
+        {
+            packed.size = frameSize * batchSize;
+            packed.allocateDataBuffer(*this);
+        }
+
+        if (packed.data == nullptr)
+        {
+            DL_INFER_LOG_ERROR("Allocation of the batch of output [%d] "
+                               "failed.\n", i);
+            packed.size = 0;
+            return -1;
+        }
+
+        m_interpreter->SetCustomAllocationForTensor(m_interpreter->outputs()[i],
+                {packed.data, static_cast<size_t>(frameSize * batchSize)});
+    }
+
+    if (m_batchSize != batchSize)
+    {
+        status = setBatchSize(batchSize);
+    }
+
+    if (status == 0)
+    {
+        if (m_interpreter->Invoke() != kTfLiteOk)
         {
             DL_INFER_LOG_ERROR("Invoke() failed.\n");
             status = -1;
         }
     }
 
+    /* Scatter the outputs back to the frames. */
+    for (uint32_t i = 0; (status == 0) && (i < m_numOutputs); i++)
+    {
+        const TfLiteTensor     *tensor = m_interpreter->output_tensor(i);
+        std::vector<int64_t>    shape(TfLiteTensorNumDims(tensor));
+
+        for (uint32_t d = 0; d < shape.size(); d++)
+        {
+            shape[d] = TfLiteTensorDim(tensor, d);
+        }
+
+        status = scatterBatch(TfLiteTensorData(tensor), shape, outputs, i);
+    }
+
     return status;
 }
 
@@ -401,19 +831,17 @@ const VecDlTensor *TFLiteInferer::getOutputInfo()
     return &m_outputs;
 }
 
-void *TFLiteInferer::allocate(int64_t size)
+int32_t TFLiteInferer::getBufferAlignment()
 {
-    auto align = [](int alignment, int64_t size) {
-        return alignment * ((size + (alignment - 1)) / alignment);
-    };
-    return aligned_alloc(tflite::kDefaultTensorAlignment,
-                align(tflite::kDefaultTensorAlignment, size));
-
+    return tflite::kDefaultTensorAlignment;
 }
 
 TFLiteInferer::~TFLiteInferer()
 {
     DL_INFER_LOG_DEBUG("DESTRUCTOR\n");
+
+    /* Drain any pending asynchronous requests. */
+    stopAsync();
 }
 
 } // namespace ti::dl_inferer
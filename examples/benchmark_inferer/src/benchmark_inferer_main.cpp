@@ -0,0 +1,1108 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <signal.h>
+#include <getopt.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <unistd.h>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+#include <ti_dl_inferer_pool.h>
+#include <ti_dl_inferer_handle.h>
+#include <ti_dl_inferer_buffer_pool.h>
+#include <ti_dl_inferer_logger.h>
+#include <ti_pre_process_config.h>
+#include <ti_post_process_cascade.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::utils;
+using namespace ti::pre_process;
+using namespace ti::post_process;
+
+#if defined(__GLIBC__)
+/* Heap allocation counter for the 'alloc' mode. The allocator entry points
+ * are interposed for the whole process and forward to glibc.
+ */
+extern "C"
+{
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t num, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t align, size_t size);
+}
+
+static atomic<bool>     gCountAllocs{false};
+static atomic<uint64_t> gNumAllocs{0};
+
+static inline void countAlloc()
+{
+    if (gCountAllocs.load(memory_order_relaxed))
+    {
+        gNumAllocs.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+extern "C" void *malloc(size_t size)
+{
+    countAlloc();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t num, size_t size)
+{
+    countAlloc();
+    return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    countAlloc();
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void *memalign(size_t align, size_t size)
+{
+    countAlloc();
+    return __libc_memalign(align, size);
+}
+
+extern "C" void *aligned_alloc(size_t align, size_t size)
+{
+    countAlloc();
+    return __libc_memalign(align, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t align, size_t size)
+{
+    countAlloc();
+    *ptr = __libc_memalign(align, size);
+    return (*ptr == nullptr) ? ENOMEM : 0;
+}
+#endif // defined(__GLIBC__)
+
+struct BenchmarkArgs
+{
+    string          modelBasePath;
+    vector<string>  modelDirs;
+    string          mode{"pool"};
+    int32_t         maxInstances{4};
+    int32_t         numIter{100};
+    bool            enableTidl{true};
+};
+
+static void showUsage(const char *name)
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# %s PARAMETERS [OPTIONAL PARAMETERS]\n", name);
+    printf("# OPTIONS:\n");
+    printf("#  --model       |-m Path to the model directory. May be repeated for the load mode.\n");
+    printf("#                    The cascade mode takes the detector first and the secondary model next.\n");
+    printf("#                    The swap mode alternates between the models given.\n");
+    printf("#  [--mode       |-b Benchmark to run. [pool|load|alloc|latency|cascade|swap|memory|contention|allocator]. Default is pool.\n");
+    printf("#                    pool: throughput of an InfererPool with 1..N instances.\n");
+    printf("#                    load: sequential vs. parallel loading of all the models.\n");
+    printf("#                    alloc: heap allocations made by steady state runs.\n");
+    printf("#                    latency: run() latency distribution of one instance.\n");
+    printf("#                    cascade: per-region vs. batched secondary model runs.\n");
+    printf("#                    swap: frame latency while models are swapped in the background.\n");
+    printf("#                    memory: resident memory of 1 and N instances with and without sharing.\n");
+    printf("#                    contention: throughput of 1..N threads calling run() on one instance.\n");
+    printf("#                    allocator: first touch and page walk time of the input buffers per allocator.\n");
+    printf("#  [--instances  |-n Maximum number of instances, threads or cascade regions. Default is 4.\n");
+    printf("#  [--iterations |-i Number of inference runs per thread. Default is 100.\n");
+    printf("#  [--tidl       |-t Enable TIDL offload [0|1]. Default is 1.\n");
+    printf("#  [--log-level  |-l Logging level to enable. [0: DEBUG 1:INFO 2:WARN 3:ERROR]. Default is 2.\n");
+    printf("#  [--help       |-h]\n");
+    printf("# \n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2022\n");
+    printf("# \n");
+    printf("# \n");
+    exit(0);
+}
+
+static void ParseCmdlineArgs(int32_t        argc,
+                             char          *argv[],
+                             BenchmarkArgs &args)
+{
+    int32_t longIndex;
+    int32_t opt;
+    static struct option long_options[] = {
+        {"help",       no_argument,       0, 'h' },
+        {"model",      required_argument, 0, 'm' },
+        {"mode",       required_argument, 0, 'b' },
+        {"instances",  required_argument, 0, 'n' },
+        {"iterations", required_argument, 0, 'i' },
+        {"tidl",       required_argument, 0, 't' },
+        {"log-level",  required_argument, 0, 'l' },
+        {0,            0,                 0,  0  }
+    };
+    LogLevel            logLevel{WARN};
+
+    while ((opt = getopt_long(argc, argv,"hm:b:n:i:t:l:",
+                   long_options, &longIndex )) != -1)
+    {
+        switch (opt)
+        {
+            case 'm' :
+                args.modelDirs.push_back(optarg);
+                break;
+
+            case 'b' :
+                args.mode = optarg;
+                break;
+
+            case 'n' :
+                args.maxInstances = strtol(optarg, NULL, 0);
+                break;
+
+            case 'i' :
+                args.numIter = strtol(optarg, NULL, 0);
+                break;
+
+            case 't' :
+                args.enableTidl = strtol(optarg, NULL, 0) != 0;
+                break;
+
+            case 'l' :
+                logLevel = static_cast<LogLevel>(strtol(optarg, NULL, 0));
+                break;
+
+            case 'h' :
+            default:
+                showUsage(argv[0]);
+                exit(-1);
+
+        } // switch (opt)
+
+    } // while ((opt = getopt_long(argc, argv
+
+    // Validate the parameters
+    if (args.modelDirs.empty() ||
+        (args.maxInstances <= 0) ||
+        (args.numIter <= 0))
+    {
+        showUsage(argv[0]);
+        exit(-1);
+    }
+
+    args.modelBasePath = args.modelDirs[0];
+
+    logSetLevel(logLevel);
+
+    return;
+
+} // End of ParseCmdLineArgs()
+
+static void freeBuffers(VecDlTensorPtr &vec)
+{
+    for (auto *t : vec)
+    {
+        delete t;
+    }
+
+    vec.clear();
+}
+
+static int32_t benchmarkPool(const InfererConfig   &config,
+                             const BenchmarkArgs   &args)
+{
+    printf("%-12s %-12s %-12s\n", "Instances", "FPS", "Latency(ms)");
+
+    for (int32_t k = 1; k <= args.maxInstances; k++)
+    {
+        InfererPool             pool(config, k);
+        vector<VecDlTensorPtr>  inputs(k);
+        vector<VecDlTensorPtr>  outputs(k);
+        vector<thread>          workers;
+        vector<int32_t>         status(k, 0);
+
+        for (int32_t i = 0; i < k; i++)
+        {
+            pool.createBuffers(pool.getInputInfo(), inputs[i], true);
+            pool.createBuffers(pool.getOutputInfo(), outputs[i], true);
+
+            for (auto *t : inputs[i])
+            {
+                memset(t->data, 0, t->size);
+            }
+        }
+
+        /* Warm up every instance once. */
+        for (int32_t i = 0; i < k; i++)
+        {
+            pool.run(inputs[i], outputs[i]);
+        }
+
+        auto start = steady_clock::now();
+
+        for (int32_t i = 0; i < k; i++)
+        {
+            workers.emplace_back([&, i]()
+            {
+                for (int32_t j = 0; j < args.numIter; j++)
+                {
+                    if (pool.run(inputs[i], outputs[i]) < 0)
+                    {
+                        status[i] = -1;
+                        break;
+                    }
+                }
+            });
+        }
+
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+
+        auto    elapsed = duration<double>(steady_clock::now() - start).count();
+        double  total = static_cast<double>(k) * args.numIter;
+
+        for (int32_t i = 0; i < k; i++)
+        {
+            freeBuffers(inputs[i]);
+            freeBuffers(outputs[i]);
+
+            if (status[i] < 0)
+            {
+                printf("[%s:%d] Inference failed.\n", __FUNCTION__, __LINE__);
+                return -1;
+            }
+        }
+
+        printf("%-12d %-12.2f %-12.3f\n",
+               k, total/elapsed, (elapsed * 1000 * k)/total);
+    }
+
+    return 0;
+}
+
+static int32_t benchmarkLoad(const BenchmarkArgs &args)
+{
+    const struct
+    {
+        const char *label;
+        int32_t     threads;
+    } runs[] = {
+        {"Sequential",  1},
+        {"Parallel",    args.maxInstances},
+    };
+
+    printf("%-12s %-8s %-12s %s\n", "Load", "Threads", "Total(ms)", "Per model(ms)");
+
+    for (const auto &r : runs)
+    {
+        vector<DLInferer *> inferers;
+        vector<float>       times;
+        int32_t             status;
+
+        auto start = steady_clock::now();
+        status = DLInferer::loadModels(args.modelDirs, args.enableTidl,
+                                       inferers, r.threads, &times);
+        auto elapsed = duration<double, milli>(steady_clock::now() - start).count();
+
+        if (status < 0)
+        {
+            printf("[%s:%d] ti::DLInferer::loadModels() failed.\n",
+                   __FUNCTION__, __LINE__);
+            return -1;
+        }
+
+        printf("%-12s %-8d %-12.2f", r.label, r.threads, elapsed);
+
+        for (auto t : times)
+        {
+            printf(" %.2f", t);
+        }
+
+        printf("\n");
+
+        for (auto *p : inferers)
+        {
+            delete p;
+        }
+    }
+
+    return 0;
+}
+
+static int32_t benchmarkAlloc(const InfererConfig  &config,
+                              const BenchmarkArgs  &args)
+{
+#if defined(__GLIBC__)
+    DLInferer      *inferer;
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    uint64_t        numAllocs[2];
+    int32_t         status = 0;
+
+    inferer = DLInferer::makeInferer(config);
+
+    if (inferer == nullptr)
+    {
+        printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+               __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    inferer->createBuffers(inferer->getInputInfo(), inputs, true);
+    inferer->createBuffers(inferer->getOutputInfo(), outputs, true);
+
+    for (auto *t : inputs)
+    {
+        memset(t->data, 0, t->size);
+    }
+
+    /* The first runs set up the bindings and grow the buffers. */
+    status = inferer->registerBuffers(inputs, outputs);
+
+    for (int32_t i = 0; (status == 0) && (i < 2); i++)
+    {
+        status = inferer->run();
+    }
+
+    /* Count over both the registered and the explicit run() calls. */
+    for (int32_t k = 0; (status == 0) && (k < 2); k++)
+    {
+        gNumAllocs = 0;
+        gCountAllocs = true;
+
+        for (int32_t i = 0; (status == 0) && (i < args.numIter); i++)
+        {
+            status = (k == 0) ? inferer->run() : inferer->run(inputs, outputs);
+        }
+
+        gCountAllocs = false;
+        numAllocs[k] = gNumAllocs;
+    }
+
+    freeBuffers(inputs);
+    freeBuffers(outputs);
+    delete inferer;
+
+    if (status < 0)
+    {
+        printf("[%s:%d] Inference failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    printf("%-16s %-12s %s\n", "Run", "Iterations", "Allocations");
+    printf("%-16s %-12d %lu\n", "run()", args.numIter, numAllocs[0]);
+    printf("%-16s %-12d %lu\n", "run(in, out)", args.numIter, numAllocs[1]);
+
+    return ((numAllocs[0] + numAllocs[1]) == 0) ? 0 : -1;
+#else
+    printf("[%s:%d] Allocation counting needs glibc.\n", __FUNCTION__, __LINE__);
+    return -1;
+#endif // defined(__GLIBC__)
+}
+
+static int32_t benchmarkLatency(const InfererConfig    &config,
+                                const BenchmarkArgs    &args)
+{
+    DLInferer      *inferer;
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    DlLatencyStats  stats;
+    int32_t         status = 0;
+
+    inferer = DLInferer::makeInferer(config);
+
+    if (inferer == nullptr)
+    {
+        printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+               __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    inferer->createBuffers(inferer->getInputInfo(), inputs, true);
+    inferer->createBuffers(inferer->getOutputInfo(), outputs, true);
+
+    for (auto *t : inputs)
+    {
+        memset(t->data, 0, t->size);
+    }
+
+    /* Leave the first run out of the statistics. */
+    status = inferer->run(inputs, outputs);
+    inferer->getStats(true);
+
+    for (int32_t i = 0; (status == 0) && (i < args.numIter); i++)
+    {
+        status = inferer->run(inputs, outputs);
+    }
+
+    stats = inferer->getStats();
+
+    freeBuffers(inputs);
+    freeBuffers(outputs);
+    delete inferer;
+
+    if (status < 0)
+    {
+        printf("[%s:%d] Inference failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    printf("%-8s %-10s %-10s %-10s %-10s %-10s %s\n", "Count", "Mean(ms)",
+           "P50(ms)", "P90(ms)", "P99(ms)", "Max(ms)", "Calls/s");
+    printf("%-8lu %-10.3f %-10.3f %-10.3f %-10.3f %-10.3f %.1f\n",
+           stats.count, stats.meanMs, stats.p50Ms, stats.p90Ms,
+           stats.p99Ms, stats.maxMs, stats.callsPerSec);
+
+    return 0;
+}
+
+static int32_t benchmarkCascade(const InfererConfig    &config,
+                                const BenchmarkArgs    &args)
+{
+    /* Size of the synthetic source frame the regions are cropped from. */
+    const int32_t           frameWidth = 1280;
+    const int32_t           frameHeight = 720;
+    InfererConfig           secConfig;
+    PreprocessImageConfig   detPreCfg;
+    PreprocessImageConfig   secPreCfg;
+    PostprocessImageConfig  postCfg;
+    DLInferer              *detector;
+    DLInferer              *secondary;
+    VecDlTensorPtr          inputs;
+    VecDlTensorPtr          outputs;
+    vector<uint8_t>         frame(frameWidth * frameHeight * 3);
+    int32_t                 status;
+
+    if (args.modelDirs.size() < 2)
+    {
+        printf("[%s:%d] The cascade mode needs a detector and a secondary "
+               "model.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    status = secConfig.getConfig(args.modelDirs[1], args.enableTidl);
+
+    if (status == 0)
+    {
+        status = detPreCfg.getConfig(args.modelDirs[0]);
+    }
+
+    if (status == 0)
+    {
+        status = secPreCfg.getConfig(args.modelDirs[1]);
+    }
+
+    if (status == 0)
+    {
+        status = postCfg.getConfig(args.modelDirs[0]);
+    }
+
+    if (status < 0)
+    {
+        printf("[%s:%d] getConfig() failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    /* The boxes are decoded straight into source frame co-ordinates. */
+    postCfg.inDataWidth   = detPreCfg.outDataWidth;
+    postCfg.inDataHeight  = detPreCfg.outDataHeight;
+    postCfg.outDataWidth  = frameWidth;
+    postCfg.outDataHeight = frameHeight;
+
+    detector  = DLInferer::makeInferer(config);
+    secondary = DLInferer::makeInferer(secConfig);
+
+    if ((detector == nullptr) || (secondary == nullptr))
+    {
+        printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+               __FUNCTION__, __LINE__);
+        delete detector;
+        delete secondary;
+        return -1;
+    }
+
+    PostprocessObjectDetection  decoder(postCfg);
+    vector<DetectionResult>     detections;
+    vector<CascadeResult>       results;
+
+    detector->createBuffers(detector->getInputInfo(), inputs, true);
+    detector->createBuffers(detector->getOutputInfo(), outputs, true);
+
+    for (auto *t : inputs)
+    {
+        memset(t->data, 0, t->size);
+    }
+
+    for (size_t i = 0; i < frame.size(); i++)
+    {
+        frame[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    printf("%-8s %-8s %-12s %-12s %s\n", "Batch", "ROIs", "Mean(ms)",
+           "P99(ms)", "Per-ROI(ms)");
+
+    for (int32_t batchSize : {1, args.maxInstances})
+    {
+        CascadeConfig   cfg;
+        CascadeFrame    src{frame.data(), frameWidth, frameHeight, 0,
+                            CascadeFrameFormat_RGB};
+        uint64_t        numRois = 0;
+
+        cfg.maxRois        = args.maxInstances;
+        cfg.batchSize      = batchSize;
+        cfg.mean           = secPreCfg.mean;
+        cfg.scale          = secPreCfg.scale;
+        cfg.dataLayout     = secPreCfg.dataLayout;
+        cfg.reverseChannel = secPreCfg.reverseChannel;
+
+        CascadeStage    stage(secondary, cfg);
+
+        for (int32_t i = 0; (status == 0) && (i <= args.numIter); i++)
+        {
+            status = detector->run(inputs, outputs);
+
+            if (status == 0)
+            {
+                status = decoder.decode(outputs, detections);
+            }
+
+            if (status == 0)
+            {
+                status = stage(src, detections, results);
+            }
+
+            /* Leave the first frame out of the statistics. */
+            if (i == 0)
+            {
+                stage.getStats(true);
+            }
+            else
+            {
+                numRois += results.size();
+            }
+        }
+
+        if (status < 0)
+        {
+            break;
+        }
+
+        DlLatencyStats  stats = stage.getStats();
+        double          roisPerFrame = static_cast<double>(numRois) / args.numIter;
+
+        printf("%-8d %-8.1f %-12.3f %-12.3f %.3f\n", batchSize, roisPerFrame,
+               stats.meanMs, stats.p99Ms,
+               (roisPerFrame > 0) ? stats.meanMs / roisPerFrame : 0.0);
+    }
+
+    freeBuffers(inputs);
+    freeBuffers(outputs);
+    delete detector;
+    delete secondary;
+
+    if (status < 0)
+    {
+        printf("[%s:%d] Cascade failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int32_t benchmarkSwap(const InfererConfig   &config,
+                             const BenchmarkArgs   &args)
+{
+    /* Number of frames between the start of two swaps. */
+    const int32_t               swapPeriod = 20;
+    vector<InfererConfig>       configs{config};
+    shared_ptr<DLInferer>       active;
+    VecDlTensorPtr              inputs;
+    VecDlTensorPtr              outputs;
+    DlLatencyHistogram          frameStats;
+    int32_t                     numSwaps = 0;
+    int32_t                     numRebuilds = 0;
+    int32_t                     status = 0;
+
+    if (args.modelDirs.size() > 1)
+    {
+        InfererConfig   next;
+
+        if (next.getConfig(args.modelDirs[1], args.enableTidl) < 0)
+        {
+            printf("[%s:%d] ti::utils::getConfig() failed.\n",
+                   __FUNCTION__, __LINE__);
+            return -1;
+        }
+
+        configs.push_back(next);
+    }
+
+    DlModelHandle   handle(config);
+
+    active = handle.acquire();
+    active->createBuffers(active->getInputInfo(), inputs, true);
+    active->createBuffers(active->getOutputInfo(), outputs, true);
+
+    for (int32_t i = 0; (status == 0) && (i < args.numIter); i++)
+    {
+        if ((i % swapPeriod) == (swapPeriod / 2))
+        {
+            handle.swap(configs[(handle.getGeneration() + 1) % configs.size()]);
+        }
+
+        DlLatencyScope  latency(frameStats);
+        auto            inferer = handle.acquire();
+
+        /* The buffers are only re-created if the new model takes different
+         * inputs or outputs.
+         */
+        if (inferer != active)
+        {
+            if (!DlModelHandle::isSameSignature(*inferer, *active))
+            {
+                freeBuffers(inputs);
+                freeBuffers(outputs);
+                inferer->createBuffers(inferer->getInputInfo(), inputs, true);
+                inferer->createBuffers(inferer->getOutputInfo(), outputs, true);
+                numRebuilds++;
+            }
+
+            active = move(inferer);
+            numSwaps++;
+        }
+
+        for (auto *t : inputs)
+        {
+            if (t->size > 0)
+            {
+                memset(t->data, 0, t->size);
+            }
+        }
+
+        status = active->run(inputs, outputs);
+    }
+
+    handle.waitSwap();
+    active.reset();
+    freeBuffers(inputs);
+    freeBuffers(outputs);
+
+    if (status < 0)
+    {
+        printf("[%s:%d] Inference failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    DlLatencyStats  stats = frameStats.getStats();
+
+    printf("%-8s %-8s %-10s %-10s %-10s %s\n", "Frames", "Swaps", "Rebuilds",
+           "Mean(ms)", "P99(ms)", "Max(ms)");
+    printf("%-8lu %-8d %-10d %-10.3f %-10.3f %.3f\n", stats.count, numSwaps,
+           numRebuilds, stats.meanMs, stats.p99Ms, stats.maxMs);
+
+    return 0;
+}
+
+/* Returns the resident set size of the process in bytes. */
+static int64_t getRss()
+{
+    FILE   *fp = fopen("/proc/self/statm", "r");
+    long    size = 0;
+    long    resident = 0;
+
+    if (fp != nullptr)
+    {
+        if (fscanf(fp, "%ld %ld", &size, &resident) != 2)
+        {
+            resident = 0;
+        }
+
+        fclose(fp);
+    }
+
+    return static_cast<int64_t>(resident) * sysconf(_SC_PAGESIZE);
+}
+
+static int32_t benchmarkMemory(const InfererConfig &config,
+                               const BenchmarkArgs &args)
+{
+    InfererConfig   cfg = config;
+
+    /* The warm-up runs would add the runtime arenas to the figures. */
+    cfg.warmupCount = 0;
+
+    printf("%-8s %-10s %-12s %s\n", "Shared", "Instances", "RSS(MB)",
+           "Per-instance(MB)");
+
+    for (bool share : {false, true})
+    {
+        for (int32_t numInstances : {1, args.maxInstances})
+        {
+            vector<DLInferer *> inferers;
+            int64_t             base = getRss();
+            int64_t             delta;
+
+            cfg.shareModel = share;
+
+            for (int32_t i = 0; i < numInstances; i++)
+            {
+                DLInferer  *inferer = DLInferer::makeInferer(cfg);
+
+                if (inferer == nullptr)
+                {
+                    printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+                           __FUNCTION__, __LINE__);
+                    break;
+                }
+
+                inferers.push_back(inferer);
+            }
+
+            delta = getRss() - base;
+
+            for (auto *inferer : inferers)
+            {
+                delete inferer;
+            }
+
+            if (static_cast<int32_t>(inferers.size()) != numInstances)
+            {
+                return -1;
+            }
+
+            printf("%-8s %-10d %-12.1f %.1f\n", share ? "yes" : "no",
+                   numInstances, delta / 1048576.0,
+                   delta / 1048576.0 / numInstances);
+        }
+    }
+
+    return 0;
+}
+
+static int32_t benchmarkContention(const InfererConfig    &config,
+                                   const BenchmarkArgs    &args)
+{
+    DLInferer  *inferer;
+    int32_t     status = 0;
+
+    inferer = DLInferer::makeInferer(config);
+
+    if (inferer == nullptr)
+    {
+        printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+               __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    printf("Concurrency: %s\n",
+           inferer->getConcurrency() == DlConcurrency_Concurrent ?
+           "concurrent" : "serialized");
+    printf("%-10s %-12s %-12s %-12s\n",
+           "Threads", "FPS", "Mean(ms)", "P99(ms)");
+
+    for (int32_t k = 1; (status == 0) && (k <= args.maxInstances); k++)
+    {
+        vector<VecDlTensorPtr>  inputs(k);
+        vector<VecDlTensorPtr>  outputs(k);
+        vector<thread>          workers;
+        vector<int32_t>         result(k, 0);
+        DlLatencyStats          stats;
+
+        /* Every caller owns its buffers. */
+        for (int32_t i = 0; i < k; i++)
+        {
+            inferer->createBuffers(inferer->getInputInfo(), inputs[i], true);
+            inferer->createBuffers(inferer->getOutputInfo(), outputs[i], true);
+
+            for (auto *t : inputs[i])
+            {
+                memset(t->data, 0, t->size);
+            }
+
+            inferer->run(inputs[i], outputs[i]);
+        }
+
+        inferer->getStats(true);
+
+        auto start = steady_clock::now();
+
+        for (int32_t i = 0; i < k; i++)
+        {
+            workers.emplace_back([&, i]()
+            {
+                for (int32_t j = 0; j < args.numIter; j++)
+                {
+                    if (inferer->run(inputs[i], outputs[i]) < 0)
+                    {
+                        result[i] = -1;
+                        break;
+                    }
+                }
+            });
+        }
+
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+
+        auto    elapsed = duration<double>(steady_clock::now() - start).count();
+        double  total = static_cast<double>(k) * args.numIter;
+
+        stats = inferer->getStats();
+
+        for (int32_t i = 0; i < k; i++)
+        {
+            freeBuffers(inputs[i]);
+            freeBuffers(outputs[i]);
+
+            if (result[i] < 0)
+            {
+                printf("[%s:%d] Inference failed.\n", __FUNCTION__, __LINE__);
+                status = -1;
+            }
+        }
+
+        if (status == 0)
+        {
+            printf("%-10d %-12.2f %-12.3f %-12.3f\n",
+                   k, total/elapsed, stats.meanMs, stats.p99Ms);
+        }
+    }
+
+    delete inferer;
+
+    return status;
+}
+
+static int32_t benchmarkAllocator(const InfererConfig  &config,
+                                  const BenchmarkArgs  &args)
+{
+    /* Walk well beyond the reach of the TLB with small pages. */
+    const int64_t   minBytes = 256 * 1024 * 1024;
+    const int64_t   stride = 4096;
+
+    printf("%-10s %-10s %-14s %-14s\n",
+           "Allocator", "MB", "Touch(ms)", "Walk(ms)");
+
+    for (const char *name : {"default", "hugepage", "memfd"})
+    {
+        InfererConfig           cfg = config;
+        DLInferer              *inferer;
+        vector<VecDlTensorPtr>  sets;
+        int64_t                 setBytes = 0;
+        int64_t                 numSets;
+        volatile uint8_t        sink = 0;
+
+        cfg.allocator   = DlAllocator::makeAllocator(name);
+        cfg.warmupCount = 0;
+        inferer = DLInferer::makeInferer(cfg);
+
+        if (inferer == nullptr)
+        {
+            printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+                   __FUNCTION__, __LINE__);
+            return -1;
+        }
+
+        for (const auto &t : *inferer->getInputInfo())
+        {
+            setBytes += t.size;
+        }
+
+        numSets = (minBytes + setBytes - 1) / setBytes;
+        sets.resize(numSets);
+
+        for (auto &set : sets)
+        {
+            inferer->createBuffers(inferer->getInputInfo(), set, true);
+        }
+
+        /* The first touch faults the pages in. */
+        auto start = steady_clock::now();
+
+        for (auto &set : sets)
+        {
+            for (auto *t : set)
+            {
+                memset(t->data, 0, t->size);
+            }
+        }
+
+        auto touched = steady_clock::now();
+
+        /* One access per small page is bound by the TLB misses. */
+        for (int32_t i = 0; i < args.numIter; i++)
+        {
+            for (auto &set : sets)
+            {
+                for (auto *t : set)
+                {
+                    const uint8_t *p = static_cast<const uint8_t *>(t->data);
+
+                    for (int64_t o = 0; o < t->size; o += stride)
+                    {
+                        sink = sink + p[o];
+                    }
+                }
+            }
+        }
+
+        auto walked = steady_clock::now();
+
+        printf("%-10s %-10.1f %-14.3f %-14.3f\n", name,
+               (setBytes * numSets) / 1048576.0,
+               duration<double, milli>(touched - start).count(),
+               duration<double, milli>(walked - touched).count() / args.numIter);
+
+        for (auto &set : sets)
+        {
+            freeBuffers(set);
+        }
+
+        delete inferer;
+
+        /* Give the cached buffers back before the next allocator. */
+        DlBufferPool::getInstance().trim();
+    }
+
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+    InfererConfig   infConfig;
+    BenchmarkArgs   args;
+    int32_t         status;
+
+    // Parse the command line options
+    ParseCmdlineArgs(argc, argv, args);
+
+    if (args.mode == "load")
+    {
+        return benchmarkLoad(args);
+    }
+
+    // Populate infConfig
+    status = infConfig.getConfig(args.modelBasePath, args.enableTidl);
+
+    if (status < 0)
+    {
+        printf("[%s:%d] ti::utils::getConfig() failed.\n",
+               __FUNCTION__, __LINE__);
+        return status;
+    }
+
+    try
+    {
+        if (args.mode == "pool")
+        {
+            status = benchmarkPool(infConfig, args);
+        }
+        else if (args.mode == "alloc")
+        {
+            status = benchmarkAlloc(infConfig, args);
+        }
+        else if (args.mode == "latency")
+        {
+            status = benchmarkLatency(infConfig, args);
+        }
+        else if (args.mode == "cascade")
+        {
+            status = benchmarkCascade(infConfig, args);
+        }
+        else if (args.mode == "swap")
+        {
+            status = benchmarkSwap(infConfig, args);
+        }
+        else if (args.mode == "memory")
+        {
+            status = benchmarkMemory(infConfig, args);
+        }
+        else if (args.mode == "contention")
+        {
+            status = benchmarkContention(infConfig, args);
+        }
+        else if (args.mode == "allocator")
+        {
+            status = benchmarkAllocator(infConfig, args);
+        }
+        else
+        {
+            printf("[%s:%d] Unknown mode [%s].\n",
+                   __FUNCTION__, __LINE__, args.mode.c_str());
+            status = -1;
+        }
+    }
+    catch (const runtime_error &e)
+    {
+        printf("[%s:%d] Exception: %s\n", __FUNCTION__, __LINE__, e.what());
+        status = -1;
+    }
+
+    return status;
+}
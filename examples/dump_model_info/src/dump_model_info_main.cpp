@@ -62,6 +62,7 @@
 /* Standard headers. */
 #include <signal.h>
 #include <getopt.h>
+#include <chrono>
 
 /* Module headers. */
 #include <ti_dl_inferer.h>
@@ -78,6 +79,7 @@ static void showUsage(const char *name)
     printf("# %s PARAMETERS [OPTIONAL PARAMETERS]\n", name);
     printf("# OPTIONS:\n");
     printf("#  --model       |-m Path to the model directory.\n");
+    printf("#  [--startup    |-s Compare the inferer creation time with and without the optimized model cache.\n");
     printf("#  [--log-level  |-l Logging level to enable. [0: DEBUG 1:INFO 2:WARN 3:ERROR]. Default is 2.\n");
     printf("#  [--help       |-h]\n");
     printf("# \n");
@@ -91,18 +93,20 @@ static void showUsage(const char *name)
 static void ParseCmdlineArgs(int32_t    argc,
                              char      *argv[],
                              string    &modelBasePath,
-                             string    &configFile)
+                             string    &configFile,
+                             bool      &startup)
 {
     int32_t longIndex;
     int32_t opt;
     static struct option long_options[] = {
         {"help",    no_argument,       0, 'h' },
         {"model",   required_argument, 0, 'm' },
+        {"startup", no_argument,       0, 's' },
         {0,         0,                 0,  0  }
     };
     LogLevel            logLevel{WARN};
 
-    while ((opt = getopt_long(argc, argv,"hm:l:", 
+    while ((opt = getopt_long(argc, argv,"hm:l:s", 
                    long_options, &longIndex )) != -1)
     {
         switch (opt)
@@ -115,6 +119,10 @@ static void ParseCmdlineArgs(int32_t    argc,
                 logLevel = static_cast<LogLevel>(strtol(optarg, NULL, 0));
                 break;
 
+            case 's' :
+                startup = true;
+                break;
+
             case 'h' :
             default:
                 showUsage(argv[0]);
@@ -139,15 +147,56 @@ static void ParseCmdlineArgs(int32_t    argc,
 
 } // End of ParseCmdLineArgs()
 
+static int32_t compareStartup(InfererConfig &infConfig)
+{
+    const struct
+    {
+        const char *label;
+        bool        cache;
+    } runs[] = {
+        {"No cache",    false},
+        {"Cache (1st)", true},
+        {"Cache (2nd)", true},
+    };
+
+    printf("%-14s %s\n", "Startup", "Time(ms)");
+
+    for (const auto &r : runs)
+    {
+        DLInferer  *inferer;
+
+        infConfig.enableModelCache = r.cache;
+
+        auto start = chrono::steady_clock::now();
+        inferer = DLInferer::makeInferer(infConfig);
+        auto end = chrono::steady_clock::now();
+
+        if (inferer == nullptr)
+        {
+            printf("[%s:%d] ti::DLInferer::makeInferer() failed.\n",
+                   __FUNCTION__, __LINE__);
+            return -1;
+        }
+
+        printf("%-14s %.2f\n", r.label,
+               chrono::duration<double, milli>(end - start).count());
+
+        delete inferer;
+    }
+
+    return 0;
+}
+
 int main(int argc, char * argv[])
 {
     InfererConfig   infConfig;
     string          modelBasePath;
     string          configFile;
+    bool            startup{false};
     int32_t         status;
 
     // Parse the command line options
-    ParseCmdlineArgs(argc, argv, modelBasePath, configFile);
+    ParseCmdlineArgs(argc, argv, modelBasePath, configFile, startup);
 
     // Populate infConfig
     status = infConfig.getConfig(modelBasePath, true);
@@ -157,6 +206,10 @@ int main(int argc, char * argv[])
         printf("[%s:%d] ti::utils::getConfig() failed.\n",
                __FUNCTION__, __LINE__);
     }
+    else if (startup)
+    {
+        status = compareStartup(infConfig);
+    }
     else
     {
         DLInferer  *inferer;
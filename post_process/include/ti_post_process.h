@@ -41,6 +41,7 @@
 
 /* Module Headers. */
 #include <ti_dl_inferer.h>
+#include <ti_dl_inferer_fp16.h>
 #include <ti_post_process_config.h>
 #include <ti_post_process_utils.h>
 
@@ -100,6 +101,13 @@ namespace ti::post_process
             /** Return the task type string. */
             const std::string &getTaskType();
 
+            /**
+             * Returns the latency statistics of the function operator.
+             *
+             * @param reset Clear the statistics after reading them
+             */
+            DlLatencyStats getStats(bool reset = false);
+
             /** Title. */
             std::string                     m_title;
 
@@ -107,6 +115,11 @@ namespace ti::post_process
             /** Configuration information. */
             const PostprocessImageConfig    m_config{};
 
+            /** Latency of the function operator. The concrete classes
+             *  record into it with a DlLatencyScope.
+             */
+            DlLatencyHistogram              m_stats;
+
         private:
             /**
              * Assignment operator.
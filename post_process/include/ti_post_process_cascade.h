@@ -0,0 +1,279 @@
+/*
+ *  Copyright (C) 2022 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_POST_PROCESS_CASCADE_
+#define _TI_POST_PROCESS_CASCADE_
+
+/* Standard headers. */
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <ti_post_process_object_detection.h>
+
+/**
+ * \defgroup group_post_process_cascade Cascade of a secondary model
+ *
+ * \brief Class running a secondary model on the regions detected by an
+ *        object detection model.
+ *
+ * \ingroup group_post_process
+ */
+
+namespace ti::post_process
+{
+    /**
+     * \brief Pixel formats of the source frame of a cascade stage.
+     *
+     * \ingroup group_post_process_cascade
+     */
+    typedef enum
+    {
+        /** Packed 8-bit RGB. */
+        CascadeFrameFormat_RGB  = 0,
+
+        /** Packed 8-bit BGR. */
+        CascadeFrameFormat_BGR  = 1,
+
+        /** 8-bit Y plane followed by an interleaved UV plane at half
+         *  resolution, both with the same pitch.
+         */
+        CascadeFrameFormat_NV12 = 2,
+    } CascadeFrameFormat;
+
+    /**
+     * \brief Source frame the regions are cropped from.
+     *
+     * \ingroup group_post_process_cascade
+     */
+    struct CascadeFrame
+    {
+        /** Pixel data. */
+        const uint8_t          *data{nullptr};
+
+        /** Width in pixels. */
+        int32_t                 width{};
+
+        /** Height in pixels. */
+        int32_t                 height{};
+
+        /** Distance in bytes between the rows. Rows are packed if 0. */
+        int32_t                 pitch{};
+
+        /** Pixel format. */
+        CascadeFrameFormat      format{CascadeFrameFormat_RGB};
+    };
+
+    /**
+     * \brief Configuration of a cascade stage. The normalization fields
+     *        match those of the pre-processing configuration of the
+     *        secondary model.
+     *
+     * \ingroup group_post_process_cascade
+     */
+    struct CascadeConfig
+    {
+        /** Maximum number of regions processed per frame. The regions with
+         *  the highest scores are kept.
+         */
+        int32_t                 maxRois{16};
+
+        /** Number of regions passed per runBatch() call. All the regions of
+         *  a frame go in a single call if 0.
+         */
+        int32_t                 batchSize{0};
+
+        /** Classes to run the secondary model on. All if empty. */
+        std::vector<int32_t>    labels;
+
+        /** Regions smaller than this, in source pixels, are skipped. */
+        int32_t                 minRoiSize{4};
+
+        /** Fraction of the box size added on each side of the region. */
+        float                   roiPadding{0.0f};
+
+        /** Mean values to apply during normalization. */
+        std::vector<float>      mean;
+
+        /** Scale values to apply during normalization. */
+        std::vector<float>      scale;
+
+        /** Layout of the secondary model input, NCHW or NHWC. */
+        std::string             dataLayout{"NCHW"};
+
+        /** If the secondary model takes the channels in BGR order. */
+        bool                    reverseChannel{false};
+    };
+
+    /**
+     * \brief Secondary model results attached to a detection.
+     *
+     * \ingroup group_post_process_cascade
+     */
+    struct CascadeResult
+    {
+        /** Detection the region was cropped from. */
+        DetectionResult         detection;
+
+        /** Index of the detection in the vector passed to the stage. */
+        int32_t                 index{};
+
+        /** Outputs of the secondary model for this region. These are owned
+         *  by the stage and are valid until its next invocation.
+         */
+        VecDlTensorPtr          outputs;
+    };
+
+   /** Runs a secondary model on the detections of a frame. The regions are
+     * cropped and resized from the source frame straight into the input
+     * tensors of the secondary model, which then runs on them in batches.
+     *
+     * The detections are expected in source frame co-ordinates, which is
+     * the case for a PostprocessObjectDetection object whose output data
+     * dimensions are those of the source frame.
+     *
+     * \ingroup group_post_process_cascade
+     */
+    class CascadeStage
+    {
+        public:
+            /** Constructor. The secondary model must have a single 4-D
+             * input with three channels. The buffers of 'maxRois' regions
+             * are allocated upfront. Throws std::runtime_error on failure.
+             *
+             * @param inferer Secondary model. The object is not owned
+             * @param config Configuration of the stage
+             */
+            CascadeStage(DLInferer              *inferer,
+                         const CascadeConfig    &config);
+
+            /** Function operator
+             *
+             * Crops the regions of 'detections' from 'frame', runs the
+             * secondary model on them and returns the results per region,
+             * in decreasing score order.
+             *
+             * @param frame Source frame
+             * @param detections Detections in source frame co-ordinates
+             * @param results Results per region. Reusing the vector across
+             *                calls avoids allocations
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t operator()(const CascadeFrame                  &frame,
+                               const std::vector<DetectionResult>  &detections,
+                               std::vector<CascadeResult>          &results);
+
+            /**
+             * Returns the latency statistics of the function operator.
+             *
+             * @param reset Clear the statistics after reading them
+             */
+            DlLatencyStats getStats(bool reset = false);
+
+            /** Destructor. */
+            ~CascadeStage();
+
+        private:
+            /** Crops and resizes region 'roi' of 'frame' into 'dst'. */
+            template <typename T>
+            void cropResize(const CascadeFrame  &frame,
+                            const float         *roi,
+                            T                   *dst);
+
+            /** Calls cropResize() for the type of the input tensor. */
+            int32_t fillInput(const CascadeFrame    &frame,
+                              const float           *roi,
+                              DlTensor              *input);
+
+        private:
+            /** Secondary model. */
+            DLInferer                      *m_inferer{nullptr};
+
+            /** Configuration. */
+            CascadeConfig                   m_config;
+
+            /** Input width of the secondary model. */
+            int32_t                         m_width{};
+
+            /** Input height of the secondary model. */
+            int32_t                         m_height{};
+
+            /** If the input of the secondary model is planar. */
+            bool                            m_planar{true};
+
+            /** Mean values per channel. */
+            float                           m_mean[3]{0.0f, 0.0f, 0.0f};
+
+            /** Scale values per channel. */
+            float                           m_scale[3]{1.0f, 1.0f, 1.0f};
+
+            /** Input buffers of each region. */
+            std::vector<VecDlTensorPtr>     m_inputs;
+
+            /** Output buffers of each region. */
+            std::vector<VecDlTensorPtr>     m_outputs;
+
+            /** Inputs of the current runBatch() call. */
+            std::vector<VecDlTensorPtr>     m_batchInputs;
+
+            /** Outputs of the current runBatch() call. */
+            std::vector<VecDlTensorPtr>     m_batchOutputs;
+
+            /** Indices of the selected detections. */
+            std::vector<int32_t>            m_order;
+
+            /** Regions of the selected detections, four values each. */
+            std::vector<float>              m_rois;
+
+            /** Horizontal source positions of the output columns. */
+            std::vector<int32_t>            m_xIdx;
+
+            /** Horizontal interpolation weights of the output columns. */
+            std::vector<float>              m_xFrac;
+
+            /** Latency of the function operator. */
+            DlLatencyHistogram              m_stats;
+
+        private:
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            CascadeStage & operator=(const CascadeStage& rhs) = delete;
+    };
+
+} // namespace ti::post_process
+
+#endif /* _TI_POST_PROCESS_CASCADE_ */
@@ -95,6 +95,11 @@ namespace ti::post_process
             /** Font for text. */
             FontProperty            m_textFont;
 
+            /** Current row of the results converted to float, for the
+             *  outputs that are not float32.
+             */
+            std::vector<float>      m_row;
+
 
         private:
             /**
@@ -89,6 +89,9 @@ namespace ti::post_process
             /** Font of result text. */
             FontProperty    m_textFont;
 
+            /** Dequantized scores, for per-channel quantized outputs. */
+            std::vector<float>  m_scores;
+
         private:
             /**
              * Assignment operator.
@@ -46,6 +46,23 @@
 
 namespace ti::post_process
 {
+    /**
+     * \brief A detection decoded from the model output.
+     *
+     * \ingroup group_post_process_obj_detection
+     */
+    struct DetectionResult
+    {
+        /** Box corners [x1, y1, x2, y2] in output data co-ordinates. */
+        float       box[4];
+
+        /** Class id, with the label offset applied. */
+        int32_t     label;
+
+        /** Score of the detection. */
+        float       score;
+    };
+
    /** Post-processing for image based object detection.
      *
      * \ingroup group_post_process_obj_detection
@@ -70,6 +87,18 @@ namespace ti::post_process
             void *operator()(void              *frameData,
                              VecDlTensorPtr    &results);
 
+            /**
+             * Decodes the detections whose score reaches the visualization
+             * threshold. The boxes are scaled to the output data dimensions.
+             *
+             * @param results Detection output results from the inference
+             * @param detections Decoded detections. The vector is cleared first
+             *
+             * @returns 0 upon success. A nagative value otherwise.
+             */
+            int32_t decode(VecDlTensorPtr                  &results,
+                           std::vector<DetectionResult>    &detections);
+
             /** Destructor. */
             ~PostprocessObjectDetection();
 
@@ -80,6 +109,9 @@ namespace ti::post_process
             /** Multiplicative factor to be applied to Y co-ordinates. */
             float                   m_scaleY{1.0f};
 
+            /** Detections of the last frame, kept to reuse the storage. */
+            std::vector<DetectionResult>    m_detections;
+
             /** Structure to hold information about NV12 Image. */
             Image                   m_imageHolder;
 
@@ -86,6 +86,18 @@ const std::string &PostprocessImage::getTaskType()
     return m_config.taskType;
 }
 
+DlLatencyStats PostprocessImage::getStats(bool reset)
+{
+    DlLatencyStats  stats = m_stats.getStats();
+
+    if (reset)
+    {
+        m_stats.reset();
+    }
+
+    return stats;
+}
+
 PostprocessImage::~PostprocessImage()
 {
 }
@@ -0,0 +1,488 @@
+/*
+ *  Copyright (C) 2022 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+/* Module headers. */
+#include <ti_post_process_cascade.h>
+#include <ti_dl_inferer_logger.h>
+
+namespace ti::post_process
+{
+using namespace std;
+using namespace ti::dl_inferer::utils;
+
+/* Converts a normalized value to the element type of the input, saturating
+ * the integer types.
+ */
+template <typename T>
+static inline T toElem(float v)
+{
+    if constexpr (is_integral_v<T>)
+    {
+        v = nearbyintf(v);
+        v = max(v, static_cast<float>(numeric_limits<T>::lowest()));
+        v = min(v, static_cast<float>(numeric_limits<T>::max()));
+    }
+
+    return static_cast<T>(v);
+}
+
+CascadeStage::CascadeStage(DLInferer            *inferer,
+                           const CascadeConfig  &config):
+    m_inferer(inferer),
+    m_config(config)
+{
+    const VecDlTensor  *inInfo;
+    const VecDlTensor  *outInfo;
+    int32_t             numChans = 0;
+    int32_t             status = 0;
+
+    if (m_inferer == nullptr)
+    {
+        DL_INFER_LOG_ERROR("Invalid secondary inferer.\n");
+        status = -1;
+    }
+    else if (m_config.maxRois < 1)
+    {
+        DL_INFER_LOG_ERROR("Invalid maximum number of regions %d.\n",
+                           m_config.maxRois);
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        inInfo  = m_inferer->getInputInfo();
+        outInfo = m_inferer->getOutputInfo();
+
+        if ((inInfo->size() != 1) || (inInfo->at(0).dim != 4))
+        {
+            DL_INFER_LOG_ERROR("The secondary model must have a single 4-D "
+                               "input.\n");
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        const auto &shape = inInfo->at(0).shape;
+
+        if (m_config.dataLayout == "NCHW")
+        {
+            numChans = shape[1];
+            m_height = shape[2];
+            m_width  = shape[3];
+            m_planar = true;
+        }
+        else if (m_config.dataLayout == "NHWC")
+        {
+            m_height = shape[1];
+            m_width  = shape[2];
+            numChans = shape[3];
+            m_planar = false;
+        }
+        else
+        {
+            DL_INFER_LOG_ERROR("Invalid data layout %s.\n",
+                               m_config.dataLayout.c_str());
+            status = -1;
+        }
+    }
+
+    if ((status == 0) && ((numChans != 3) || (m_width <= 0) || (m_height <= 0)))
+    {
+        DL_INFER_LOG_ERROR("Unsupported secondary input shape [C=%d H=%d W=%d].\n",
+                           numChans, m_height, m_width);
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            if (m_config.mean.size() > i)
+            {
+                m_mean[i] = m_config.mean[i];
+            }
+
+            if (m_config.scale.size() > i)
+            {
+                m_scale[i] = m_config.scale[i];
+            }
+        }
+
+        m_config.minRoiSize = max(m_config.minRoiSize, 1);
+
+        m_inputs.resize(m_config.maxRois);
+        m_outputs.resize(m_config.maxRois);
+        m_batchInputs.reserve(m_config.maxRois);
+        m_batchOutputs.reserve(m_config.maxRois);
+        m_rois.resize(m_config.maxRois * 4);
+        m_xIdx.resize(m_width);
+        m_xFrac.resize(m_width);
+
+        for (int32_t i = 0; (i < m_config.maxRois) && (status == 0); i++)
+        {
+            status = m_inferer->createBuffers(inInfo, m_inputs[i], true);
+
+            if (status == 0)
+            {
+                status = m_inferer->createBuffers(outInfo, m_outputs[i], true);
+            }
+        }
+
+        if (status < 0)
+        {
+            DL_INFER_LOG_ERROR("createBuffers() failed.\n");
+        }
+    }
+
+    if (status < 0)
+    {
+        throw runtime_error("CascadeStage object creation failed.");
+    }
+}
+
+template <typename T>
+void CascadeStage::cropResize(const CascadeFrame   &frame,
+                              const float          *roi,
+                              T                    *dst)
+{
+    const bool      nv12 = frame.format == CascadeFrameFormat_NV12;
+    const int32_t   pitch = (frame.pitch > 0) ? frame.pitch :
+                            (nv12 ? frame.width : frame.width * 3);
+    const int32_t   maxX = frame.width - 1;
+    const int32_t   maxY = frame.height - 1;
+    const int32_t   planeSize = m_width * m_height;
+    const float     stepX = (roi[2] - roi[0]) / m_width;
+    const float     stepY = (roi[3] - roi[1]) / m_height;
+    const uint8_t  *uvPlane = frame.data + pitch * frame.height;
+    int32_t         srcChan[3];
+
+    /* Source component feeding each output channel. */
+    for (int32_t c = 0; c < 3; c++)
+    {
+        int32_t rgb = m_config.reverseChannel ? 2 - c : c;
+
+        srcChan[c] = (frame.format == CascadeFrameFormat_BGR) ? 2 - rgb : rgb;
+    }
+
+    auto store = [&](int32_t x, int32_t y, const float *px)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            float   v = (px[srcChan[c]] - m_mean[c]) * m_scale[c];
+            int32_t o = m_planar ? (c * planeSize + y * m_width + x) :
+                                   ((y * m_width + x) * 3 + c);
+
+            dst[o] = toElem<T>(v);
+        }
+    };
+
+    /* The sampling positions are shared by all the rows. */
+    for (int32_t x = 0; x < m_width; x++)
+    {
+        float fx = roi[0] + (x + 0.5f) * stepX - 0.5f;
+
+        fx = min(max(fx, 0.0f), static_cast<float>(maxX));
+        m_xIdx[x]  = static_cast<int32_t>(fx);
+        m_xFrac[x] = fx - m_xIdx[x];
+    }
+
+    for (int32_t y = 0; y < m_height; y++)
+    {
+        float   fy = roi[1] + (y + 0.5f) * stepY - 0.5f;
+        int32_t iy;
+        float   wy;
+
+        fy = min(max(fy, 0.0f), static_cast<float>(maxY));
+        iy = static_cast<int32_t>(fy);
+        wy = fy - iy;
+
+        const uint8_t  *row0 = frame.data + iy * pitch;
+        const uint8_t  *row1 = frame.data + min(iy + 1, maxY) * pitch;
+
+        if (nv12)
+        {
+            /* Luma is interpolated, chroma is sampled at half resolution. */
+            const uint8_t  *uvRow = uvPlane + (min(iy + (wy >= 0.5f), maxY) >> 1) * pitch;
+
+            for (int32_t x = 0; x < m_width; x++)
+            {
+                int32_t         ix0 = m_xIdx[x];
+                int32_t         ix1 = min(ix0 + 1, maxX);
+                float           wx = m_xFrac[x];
+                float           top = row0[ix0] + (row0[ix1] - row0[ix0]) * wx;
+                float           bot = row1[ix0] + (row1[ix1] - row1[ix0]) * wx;
+                float           luma = top + (bot - top) * wy;
+                const uint8_t  *uv = uvRow + ((ix0 + (wx >= 0.5f)) & ~1);
+                float           u = uv[0] - 128.0f;
+                float           v = uv[1] - 128.0f;
+                float           px[3];
+
+                px[0] = luma + 1.402f * v;
+                px[1] = luma - 0.344f * u - 0.714f * v;
+                px[2] = luma + 1.772f * u;
+
+                for (auto &p : px)
+                {
+                    p = min(max(p, 0.0f), 255.0f);
+                }
+
+                store(x, y, px);
+            }
+        }
+        else
+        {
+            for (int32_t x = 0; x < m_width; x++)
+            {
+                const uint8_t  *p00 = row0 + m_xIdx[x] * 3;
+                const uint8_t  *p01 = row0 + min(m_xIdx[x] + 1, maxX) * 3;
+                const uint8_t  *p10 = row1 + m_xIdx[x] * 3;
+                const uint8_t  *p11 = row1 + min(m_xIdx[x] + 1, maxX) * 3;
+                float           wx = m_xFrac[x];
+                float           px[3];
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    float top = p00[c] + (p01[c] - p00[c]) * wx;
+                    float bot = p10[c] + (p11[c] - p10[c]) * wx;
+
+                    px[c] = top + (bot - top) * wy;
+                }
+
+                store(x, y, px);
+            }
+        }
+    }
+}
+
+int32_t CascadeStage::fillInput(const CascadeFrame &frame,
+                                const float        *roi,
+                                DlTensor           *input)
+{
+    int32_t status = 0;
+
+    if (input->type == DlInferType_Int8)
+    {
+        cropResize(frame, roi, reinterpret_cast<int8_t*>(input->data));
+    }
+    else if (input->type == DlInferType_UInt8)
+    {
+        cropResize(frame, roi, reinterpret_cast<uint8_t*>(input->data));
+    }
+    else if (input->type == DlInferType_Int16)
+    {
+        cropResize(frame, roi, reinterpret_cast<int16_t*>(input->data));
+    }
+    else if (input->type == DlInferType_UInt16)
+    {
+        cropResize(frame, roi, reinterpret_cast<uint16_t*>(input->data));
+    }
+    else if (input->type == DlInferType_Float16)
+    {
+        cropResize(frame, roi, reinterpret_cast<DlFloat16*>(input->data));
+    }
+    else if (input->type == DlInferType_Float32)
+    {
+        cropResize(frame, roi, reinterpret_cast<float*>(input->data));
+    }
+    else
+    {
+        DL_INFER_LOG_ERROR("Unsupported secondary input type %d.\n",
+                           input->type);
+        status = -1;
+    }
+
+    return status;
+}
+
+int32_t CascadeStage::operator()(const CascadeFrame                    &frame,
+                                 const std::vector<DetectionResult>    &detections,
+                                 std::vector<CascadeResult>            &results)
+{
+    DlLatencyScope  latency(m_stats);
+    DL_INFER_TRACE_SCOPE("CascadeStage");
+
+    const auto     &labels = m_config.labels;
+    const float     width = static_cast<float>(frame.width);
+    const float     height = static_cast<float>(frame.height);
+    int32_t         numRois;
+    int32_t         batchSize;
+    int32_t         status = 0;
+
+    if ((frame.data == nullptr) || (frame.width <= 0) || (frame.height <= 0))
+    {
+        DL_INFER_LOG_ERROR("Invalid source frame.\n");
+        results.clear();
+        return -1;
+    }
+
+    /* Select the detections of the classes of interest that are large
+     * enough once clipped to the frame.
+     */
+    m_order.clear();
+
+    for (uint32_t i = 0; i < detections.size(); i++)
+    {
+        const auto &box = detections[i].box;
+
+        if (!labels.empty() &&
+            (find(labels.begin(), labels.end(), detections[i].label) == labels.end()))
+        {
+            continue;
+        }
+
+        if (((min(box[2], width) - max(box[0], 0.0f)) < m_config.minRoiSize) ||
+            ((min(box[3], height) - max(box[1], 0.0f)) < m_config.minRoiSize))
+        {
+            continue;
+        }
+
+        m_order.push_back(i);
+    }
+
+    numRois = min(static_cast<int32_t>(m_order.size()), m_config.maxRois);
+
+    partial_sort(m_order.begin(), m_order.begin() + numRois, m_order.end(),
+                 [&detections](int32_t a, int32_t b)
+                 {
+                     return detections[a].score > detections[b].score;
+                 });
+
+    results.resize(numRois);
+
+    for (int32_t r = 0; r < numRois; r++)
+    {
+        const auto &box = detections[m_order[r]].box;
+        float      *roi = &m_rois[r * 4];
+        float       padX = (box[2] - box[0]) * m_config.roiPadding;
+        float       padY = (box[3] - box[1]) * m_config.roiPadding;
+
+        roi[0] = max(box[0] - padX, 0.0f);
+        roi[1] = max(box[1] - padY, 0.0f);
+        roi[2] = min(box[2] + padX, width);
+        roi[3] = min(box[3] + padY, height);
+    }
+
+    batchSize = (m_config.batchSize > 0) ? m_config.batchSize : numRois;
+
+    for (int32_t b = 0; (b < numRois) && (status == 0); b += batchSize)
+    {
+        int32_t n = min(batchSize, numRois - b);
+
+        for (int32_t r = b; (r < b + n) && (status == 0); r++)
+        {
+            status = fillInput(frame, &m_rois[r * 4], m_inputs[r][0]);
+        }
+
+        if (status < 0)
+        {
+            break;
+        }
+
+        /* Lend the buffers of the regions to the batch without copying
+         * the vectors, so that steady state calls do not allocate.
+         */
+        m_batchInputs.resize(n);
+        m_batchOutputs.resize(n);
+
+        for (int32_t i = 0; i < n; i++)
+        {
+            m_batchInputs[i].swap(m_inputs[b + i]);
+            m_batchOutputs[i].swap(m_outputs[b + i]);
+        }
+
+        status = m_inferer->runBatch(m_batchInputs, m_batchOutputs);
+
+        for (int32_t i = 0; i < n; i++)
+        {
+            m_batchInputs[i].swap(m_inputs[b + i]);
+            m_batchOutputs[i].swap(m_outputs[b + i]);
+        }
+
+        m_batchInputs.clear();
+        m_batchOutputs.clear();
+
+        if (status < 0)
+        {
+            DL_INFER_LOG_ERROR("runBatch() failed.\n");
+        }
+    }
+
+    if (status < 0)
+    {
+        results.clear();
+        return status;
+    }
+
+    for (int32_t r = 0; r < numRois; r++)
+    {
+        results[r].detection = detections[m_order[r]];
+        results[r].index     = m_order[r];
+        results[r].outputs   = m_outputs[r];
+    }
+
+    return 0;
+}
+
+DlLatencyStats CascadeStage::getStats(bool reset)
+{
+    DlLatencyStats  stats = m_stats.getStats();
+
+    if (reset)
+    {
+        m_stats.reset();
+    }
+
+    return stats;
+}
+
+CascadeStage::~CascadeStage()
+{
+    for (auto *vec : {&m_inputs, &m_outputs})
+    {
+        for (auto &set : *vec)
+        {
+            for (auto *t : set)
+            {
+                delete t;
+            }
+        }
+    }
+}
+
+} // namespace ti::post_process
@@ -32,6 +32,7 @@
 
 /* Module headers. */
 #include <ti_post_process_human_pose_estimation.h>
+#include <ti_dl_inferer_quant.h>
 
 namespace ti::post_process
 {
@@ -115,9 +116,10 @@ PostprocessHumanPoseEstimation::PostprocessHumanPoseEstimation(const Postprocess
 void *PostprocessHumanPoseEstimation::operator()(void           *frameData,
                                                  VecDlTensorPtr &results)
 {
+    DlLatencyScope  latency(m_stats);
+    DL_INFER_TRACE_SCOPE("PostprocessHumanPoseEstimation");
     void *ret = frameData;
     auto *result = results[0];
-    float* data = (float*)result->data;
     m_imageHolder.yRowAddr = (uint8_t *)frameData;
     m_imageHolder.uvRowAddr = (uint8_t *)frameData + (m_imageHolder.width*m_imageHolder.height);
     auto height = result->shape[result->dim - 2];
@@ -129,22 +131,44 @@ void *PostprocessHumanPoseEstimation::operator()(void           *frameData,
         float det_score;
         int det_label;
         vector<float> kpt;
+        const float *row;
+        int64_t offset = i * width;
 
-        det_score = data[i * width + 4];
-        det_label = int(data[i * width + 5]);
+        if (result->type == DlInferType_Float32)
+        {
+            row = (float*)result->data + offset;
+        }
+        else
+        {
+            /* Compare the score in the domain it is stored in, and convert
+             * only the rows that are kept to float.
+             */
+            if (getRawValue(*result, offset + 4) <=
+                quantizeThreshold(*result, offset + 4, m_config.vizThreshold))
+            {
+                continue;
+            }
+
+            m_row.resize(width);
+            dequantize(*result, offset, width, m_row.data());
+            row = m_row.data();
+        }
+
+        det_score = row[4];
+        det_label = int(row[5]);
 
         if(det_score > m_config.vizThreshold) {
             YUVColor color_map = m_yuvColorMap[det_label];
 
             for(int j = 6; j < width; j++)
             {
-                kpt.push_back(data[i * width + j]);
+                kpt.push_back(row[j]);
             }
 
-            det_bbox.push_back(data[i * width + 0] * m_scaleX);
-            det_bbox.push_back(data[i * width + 1] * m_scaleY);
-            det_bbox.push_back(data[i * width + 2] * m_scaleX);
-            det_bbox.push_back(data[i * width + 3] * m_scaleY);
+            det_bbox.push_back(row[0] * m_scaleX);
+            det_bbox.push_back(row[1] * m_scaleY);
+            det_bbox.push_back(row[2] * m_scaleX);
+            det_bbox.push_back(row[3] * m_scaleY);
 
             drawRect(&m_imageHolder,
                      det_bbox[0],
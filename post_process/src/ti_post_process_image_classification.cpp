@@ -32,6 +32,7 @@
 
 /* Module headers. */
 #include <ti_post_process_image_classification.h>
+#include <ti_dl_inferer_quant.h>
 
 namespace ti::post_process
 {
@@ -39,7 +40,7 @@ using namespace std;
 
 #define INVOKE_OVERLAY_CLASS_LOGIC(T)                    \
     overlayTopNClasses(frameData,                        \
-                       reinterpret_cast<T*>(buff->data), \
+                       reinterpret_cast<T*>(data),       \
                        m_config.classnames,              \
                        labelOffset,                      \
                        m_config.topN,                    \
@@ -204,42 +205,63 @@ static T1 *overlayTopNClasses(T1                   *frame,
 void *PostprocessImageClassification::operator()(void            *frameData,
                                                  VecDlTensorPtr  &results)
 {
+    DlLatencyScope  latency(m_stats);
+    DL_INFER_TRACE_SCOPE("PostprocessImageClassification");
+
     /* Even though a vector of variants is passed only the first
      * entry is valid.
      */
     auto       *buff = results[0];
     void       *ret = frameData;
+    void       *data = buff->data;
+    DlInferType type = buff->type;
     int32_t     labelOffset = m_config.labelOffsetMap.at(0);
 
-    if (buff->type == DlInferType_Int8)
+    /* Per-tensor quantization keeps the order of the scores, hence the top
+     * classes are picked on the stored values. Per-channel parameters need
+     * the scores to be dequantized first.
+     */
+    if (buff->quant.scale.size() > 1)
+    {
+        m_scores.resize(buff->numElem);
+        dequantize(*buff, 0, buff->numElem, m_scores.data());
+        data = m_scores.data();
+        type = DlInferType_Float32;
+    }
+
+    if (type == DlInferType_Int8)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(int8_t);
     }
-    else if (buff->type == DlInferType_UInt8)
+    else if (type == DlInferType_UInt8)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(uint8_t);
     }
-    else if (buff->type == DlInferType_Int16)
+    else if (type == DlInferType_Int16)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(int16_t);
     }
-    else if (buff->type == DlInferType_UInt16)
+    else if (type == DlInferType_UInt16)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(uint16_t);
     }
-    else if (buff->type == DlInferType_Int32)
+    else if (type == DlInferType_Int32)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(int32_t);
     }
-    else if (buff->type == DlInferType_UInt32)
+    else if (type == DlInferType_UInt32)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(uint32_t);
     }
-    else if (buff->type == DlInferType_Int64)
+    else if (type == DlInferType_Int64)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(int64_t);
     }
-    else if (buff->type == DlInferType_Float32)
+    else if (type == DlInferType_Float16)
+    {
+        ret = INVOKE_OVERLAY_CLASS_LOGIC(DlFloat16);
+    }
+    else if (type == DlInferType_Float32)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(float);
     }
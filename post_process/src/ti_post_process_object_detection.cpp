@@ -32,10 +32,13 @@
 
 /* Module headers. */
 #include <ti_post_process_object_detection.h>
+#include <ti_dl_inferer_quant.h>
+#include <ti_dl_inferer_logger.h>
 
 namespace ti::post_process
 {
 using namespace std;
+using namespace ti::dl_inferer::utils;
 PostprocessObjectDetection::PostprocessObjectDetection(const PostprocessImageConfig   &config):
     PostprocessImage(config)
 {
@@ -102,6 +105,37 @@ static void overlayBoundingBox(Image                        *img,
 
 void *PostprocessObjectDetection::operator()(void           *frameData,
                                             VecDlTensorPtr &results)
+{
+    DlLatencyScope  latency(m_stats);
+    DL_INFER_TRACE_SCOPE("PostprocessObjectDetection");
+
+    void   *ret = frameData;
+
+    decode(results, m_detections);
+
+    m_imageHolder.yRowAddr = (uint8_t *)frameData;
+    m_imageHolder.uvRowAddr = (uint8_t *)frameData + (m_imageHolder.width*m_imageHolder.height);
+
+    for (const auto &det : m_detections)
+    {
+        int box[4];
+
+        box[0] = det.box[0];
+        box[1] = det.box[1];
+        box[2] = det.box[2];
+        box[3] = det.box[3];
+
+        const std::string objectname = m_config.classnames.at(det.label);
+        overlayBoundingBox( &m_imageHolder, box, objectname,
+                            &m_boxColor, &m_textColor, &m_textBGColor,
+                            &m_textFont);
+    }
+
+    return ret;
+}
+
+int32_t PostprocessObjectDetection::decode(VecDlTensorPtr                 &results,
+                                           std::vector<DetectionResult>   &detections)
 {
     /* The results has three vectors. We assume that the type
      * of all these is the same.
@@ -109,7 +143,14 @@ void *PostprocessObjectDetection::operator()(void           *frameData,
     std::vector<int64_t>    lastDims;
     VecDlTensorPtr          resultRo;
     int32_t                 ignoreIndex;
-    void                   *ret     = frameData;
+
+    detections.clear();
+
+    if (results.empty())
+    {
+        DL_INFER_LOG_ERROR("No detection results.\n");
+        return -1;
+    }
 
     /* Extract the last dimension from each of the output
      * tensors.
@@ -150,7 +191,13 @@ void *PostprocessObjectDetection::operator()(void           *frameData,
 
     ignoreIndex = m_config.ignoreIndex;
 
-    auto getVal = [&ignoreIndex, &lastDims, &resultRo] (int32_t iter, int32_t pos)
+    /* Locates the tensor and the offset holding field 'pos' of entry
+     * 'iter'. Returns false if the field does not exist.
+     */
+    auto locate = [&ignoreIndex, &lastDims, &resultRo] (int32_t      iter,
+                                                        int32_t      pos,
+                                                        DlTensor   *&tensor,
+                                                        int64_t     &offset)
     {
         int64_t cumuDims = 0;
 
@@ -159,80 +206,81 @@ void *PostprocessObjectDetection::operator()(void           *frameData,
             cumuDims += lastDims[i];
             if (ignoreIndex != -1 && pos >= ignoreIndex)
                 pos++;
-            auto offset = iter * lastDims[i] + pos - cumuDims + lastDims[i];
 
             if (pos < cumuDims)
             {
-                if (resultRo[i]->type == DlInferType_Int8)
-                {
-                    return (float)reinterpret_cast<int8_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_UInt8)
-                {
-                    return (float)reinterpret_cast<uint8_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_Int16)
-                {
-                    return (float)reinterpret_cast<int16_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_UInt16)
-                {
-                    return (float)reinterpret_cast<uint16_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_Int32)
-                {
-                    return (float)reinterpret_cast<int32_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_UInt32)
-                {
-                    return (float)reinterpret_cast<uint32_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_Int64)
-                {
-                    return (float)reinterpret_cast<int64_t*>(resultRo[i]->data)[offset];
-                }
-                else if (resultRo[i]->type == DlInferType_Float32)
-                {
-                    return (float)reinterpret_cast<float*>(resultRo[i]->data)[offset];
-                }
+                tensor = resultRo[i];
+                offset = iter * lastDims[i] + pos - cumuDims + lastDims[i];
+                return true;
             }
         }
 
-        return (float)0;
+        return false;
     };
 
-    m_imageHolder.yRowAddr = (uint8_t *)frameData;
-    m_imageHolder.uvRowAddr = (uint8_t *)frameData + (m_imageHolder.width*m_imageHolder.height);
+    /* Quantized outputs are dequantized only for the values used. */
+    auto getVal = [&locate] (int32_t iter, int32_t pos)
+    {
+        DlTensor   *tensor;
+        int64_t     offset;
+
+        if (locate(iter, pos, tensor, offset))
+        {
+            return getValue(*tensor, offset);
+        }
+
+        return (float)0;
+    };
 
     int32_t numEntries = resultRo[0]->numElem/lastDims[0];
+    float scoreThreshold = m_config.vizThreshold;
+    DlTensor *scoreTensor;
+    int64_t scoreOffset;
+
+    /* Compare the score in the domain it is stored in. The threshold only
+     * changes across entries with per-channel parameters.
+     */
+    if (locate(0, m_config.formatter[5], scoreTensor, scoreOffset))
+    {
+        scoreThreshold = quantizeThreshold(*scoreTensor,
+                                           scoreOffset,
+                                           m_config.vizThreshold);
+    }
 
     for (auto i = 0; i < numEntries; i++)
     {
-        float score;
-        int label, box[4];
-        score = getVal(i, m_config.formatter[5]);
+        DetectionResult det;
 
-        if (score < m_config.vizThreshold)
+        if (!locate(i, m_config.formatter[5], scoreTensor, scoreOffset))
+        {
+            continue;
+        }
+
+        if (scoreTensor->quant.scale.size() > 1)
+        {
+            scoreThreshold = quantizeThreshold(*scoreTensor,
+                                               scoreOffset,
+                                               m_config.vizThreshold);
+        }
+
+        if (getRawValue(*scoreTensor, scoreOffset) < scoreThreshold)
         {
             continue;
         }
         
-        box[0] = getVal(i, m_config.formatter[0]) * m_scaleX;
-        box[1] = getVal(i, m_config.formatter[1]) * m_scaleY;
-        box[2] = getVal(i, m_config.formatter[2]) * m_scaleX;
-        box[3] = getVal(i, m_config.formatter[3]) * m_scaleY;
+        det.box[0] = getVal(i, m_config.formatter[0]) * m_scaleX;
+        det.box[1] = getVal(i, m_config.formatter[1]) * m_scaleY;
+        det.box[2] = getVal(i, m_config.formatter[2]) * m_scaleX;
+        det.box[3] = getVal(i, m_config.formatter[3]) * m_scaleY;
+        det.score  = getValue(*scoreTensor, scoreOffset);
 
-        label = getVal(i, m_config.formatter[4]);
+        int32_t label = getVal(i, m_config.formatter[4]);
+        det.label = m_config.labelOffsetMap.at(label);
 
-        int32_t adj_class_id = m_config.labelOffsetMap.at(label);
-        const std::string objectname = m_config.classnames.at(adj_class_id);
-        overlayBoundingBox( &m_imageHolder, box, objectname,
-                            &m_boxColor, &m_textColor, &m_textBGColor,
-                            &m_textFont);
+        detections.push_back(det);
     }
 
-
-    return ret;
+    return 0;
 }
 
 PostprocessObjectDetection::~PostprocessObjectDetection()
@@ -146,6 +146,9 @@ static T1 *blendSegMask(T1         *frame,
 void *PostprocessSemanticSegmentation::operator()(void             *frameData,
                                                   VecDlTensorPtr   &results)
 {
+    DlLatencyScope  latency(m_stats);
+    DL_INFER_TRACE_SCOPE("PostprocessSemanticSegmentation");
+
     /* Even though a vector of variants is passed only the first
      * entry is valid.
      */
@@ -180,6 +183,10 @@ void *PostprocessSemanticSegmentation::operator()(void             *frameData,
     {
         ret = INVOKE_BLEND_LOGIC(int64_t);
     }
+    else if (buff->type == DlInferType_Float16)
+    {
+        ret = INVOKE_BLEND_LOGIC(DlFloat16);
+    }
     else if (buff->type == DlInferType_Float32)
     {
         ret = INVOKE_BLEND_LOGIC(float);
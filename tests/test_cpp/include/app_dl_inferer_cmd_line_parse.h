@@ -61,6 +61,9 @@ namespace ti::app_dl_inferer::common
             /** Enable TIDL. */
             bool                        enableTidl{true};
 
+            /** Use the synthetic inferer instead of the model runtime. */
+            bool                        nullInferer{false};
+
             /** Log Level. */
             std::string                 logLevel{"1"};
     };
@@ -92,9 +92,11 @@ namespace ti::app_dl_inferer::common
              *
              * @param inputBuff input data
              * @param originalBuff original frame for post Processing
+             * @param inputPitch distance in bytes between two rows of the
+             *                   input data, 0 if the rows are packed
              * @returns zero on success, non-zero on failure
              */
-            int runModel(void *inputBuff,void *originalBuff);
+            int runModel(void *inputBuff,void *originalBuff,int32_t inputPitch = 0);
 
             /** Destructor. */
             ~InferencePipe();
@@ -56,6 +56,7 @@ static void showUsage(const char *name)
     printf("#  [--alpha  |-a Alpha value for blending in semantic segmentation. Default is 0.4.\n");
     printf("#  [--top_n   |-t Top N classes for image classification. Default is 5.]\n");
     printf("#  [--disable_tidl    |-e Disable TIDL.]\n");
+    printf("#  [--null_inferer    |-n Replace the model with the synthetic inferer.]\n");
     printf("#  [--log-level  |-l Logging level to enable. [0: DEBUG 1:INFO 2:WARN 3:ERROR]. Default is 2.\n");
     printf("#  [--help       |-h]\n");
     printf("# \n");
@@ -73,6 +74,7 @@ CmdlineArgs::parse(int32_t        argc,
     static struct option long_options[] = {
         {"help",            no_argument,       0, 'h'},
         {"disable_tidl",    no_argument,       0, 'e' },
+        {"null_inferer",    no_argument,       0, 'n' },
         {"top_n",           no_argument,       0, 't' },
         {"alpha",           no_argument,       0, 'a' },
         {"viz_threshold",   no_argument,       0, 'v' },
@@ -81,7 +83,7 @@ CmdlineArgs::parse(int32_t        argc,
         {0,                 0,                 0,  0  }
     };
 
-    while ((opt = getopt_long(argc, argv,"-het:a:v:i:d:",
+    while ((opt = getopt_long(argc, argv,"-hent:a:v:i:d:",
                    long_options, &longIndex )) != -1)
     {
         switch (opt)
@@ -110,6 +112,10 @@ CmdlineArgs::parse(int32_t        argc,
             case 'e' :
                 enableTidl = false;
                 break;
+
+            case 'n' :
+                nullInferer = true;
+                break;
             
             case 'l' :
                 logLevel = optarg;
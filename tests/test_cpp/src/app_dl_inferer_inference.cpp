@@ -34,22 +34,25 @@
 #include <test_cpp/include/app_dl_inferer_utils.h>
 #include <test_cpp/include/app_dl_inferer_inference.h>
 
-#define TI_EDGEAI_GET_TIME() chrono::system_clock::now()
+#define TI_EDGEAI_GET_TIME() DlLatencyHistogram::now()
 
-#define TI_EDGEAI_GET_DIFF(_START, _END) \
-chrono::duration_cast<chrono::milliseconds>(_END - _START).count()
+#define TI_EDGEAI_GET_DIFF(_START, _END) ((_END - _START) / 1e6)
 
 namespace ti::app_dl_inferer::common
 {
-/* Alias for time point type */
-using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+/* Alias for time point type, in nano-seconds of a monotonic clock. */
+using TimePoint = uint64_t;
 
 template <typename InputT, typename OutputT>
 int32_t normalize(InputT  *inData,
                   OutputT *outData,
+                  int32_t  inPitch,
+                  DlTensorLayout layout,
                   PreprocessImageConfig &config)
 {
+    DL_INFER_TRACE_SCOPE("normalize");
     int32_t         status   = 0;
+    InputT         *inRow    = inData;
     float           mean[3]  = {0,0,0};
     float           scale[3] = {1,1,1};
 
@@ -65,8 +68,14 @@ int32_t normalize(InputT  *inData,
         }
     }
 
-    //Input format is assumed to be HWC packed and assume n = 1
-    if (config.dataLayout == "NCHW")
+    // Rows are packed unless a pitch is given
+    if (inPitch == 0)
+    {
+        inPitch = config.outDataWidth * 3;
+    }
+
+    //Input format is assumed to be HWC and assume n = 1
+    if (layout == DlTensorLayout_NCHW)
     {
         for (int h = 0; h < config.outDataHeight; h++)
         {
@@ -74,7 +83,7 @@ int32_t normalize(InputT  *inData,
             {
                 for (int c = 0; c < 3; c++)
                 {
-                    OutputT val = inData[h * config.outDataWidth * 3 + w * 3 + c];
+                    OutputT val = inData[h * inPitch + w * 3 + c];
                     val = (val - mean[c]) * scale[c];
                     outData[c * config.outDataWidth * config.outDataHeight + h * config.outDataWidth + w] = val;
                 }
@@ -82,12 +91,14 @@ int32_t normalize(InputT  *inData,
         }
     }
 
-    else if (config.dataLayout == "NHWC")
+    else if (layout == DlTensorLayout_NHWC)
     {
         // 'inData' and 'outData' have the same data formats but different
         // data types and hence element widths.
         for (int h = 0; h < config.outDataHeight; h++)
         {
+            inData = inRow + h * inPitch;
+
             for (int w = 0; w < config.outDataWidth; w++)
             {
                 for (int c = 0; c < 3; c++)
@@ -149,6 +160,14 @@ InferencePipe::InferencePipe(DLInferer                 *infererObj,
         {
             DL_INFER_LOG_ERROR("createBuffers(m_inferInputBuff) failed.\n");
         }
+        else if (m_preProcCfg.dataLayout == "NCHW")
+        {
+            m_inferInputBuff[0]->layout = DlTensorLayout_NCHW;
+        }
+        else if (m_preProcCfg.dataLayout == "NHWC")
+        {
+            m_inferInputBuff[0]->layout = DlTensorLayout_NHWC;
+        }
     }
 
     if (status < 0)
@@ -162,65 +181,96 @@ int32_t InferencePipe::getInstId()
     return m_instId;
 }
 
-int InferencePipe::runModel(void *inputBuff,void *originalBuff)
+int InferencePipe::runModel(void *inputBuff,void *originalBuff,int32_t inputPitch)
 {
+    DL_INFER_TRACE_SCOPE("InferencePipe::runModel");
     TimePoint   start;
     TimePoint   end;
+    float       preDiff;
     float       diff;
 
     auto       *buff = m_inferInputBuff[0];
     int32_t     ret;
     int32_t     status;
 
+    start = TI_EDGEAI_GET_TIME();
+
     if (buff->type == DlInferType_Int8)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<int8_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_UInt8)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<uint8_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_Int16)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<int16_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_UInt16)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<uint16_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_Int32)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<int32_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_UInt32)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<uint32_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_Int64)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<int64_t*>(buff->data),
+                        inputPitch,
+                        buff->layout,
+                        m_preProcCfg);
+    }
+    else if (buff->type == DlInferType_Float16)
+    {
+        ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
+                        reinterpret_cast<DlFloat16*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
     else if (buff->type == DlInferType_Float32)
     {
         ret = normalize(reinterpret_cast<const uint8_t*>(inputBuff),
                         reinterpret_cast<float*>(buff->data),
+                        inputPitch,
+                        buff->layout,
                         m_preProcCfg);
     }
 
+    end = TI_EDGEAI_GET_TIME();
+    preDiff = TI_EDGEAI_GET_DIFF(start, end);
+
     // Run the model
     start = TI_EDGEAI_GET_TIME();
     status = m_inferer->run(m_inferInputBuff, m_inferOutputBuff);
@@ -233,7 +283,8 @@ int InferencePipe::runModel(void *inputBuff,void *originalBuff)
         throw runtime_error("Inference failed.\n");
     }
 
-    printf("\n[STATS] Inference-%d took %.2fms\n" , m_instId, diff);
+    printf("\n[STATS] PreProcess-%d took %.2fms\n" , m_instId, preDiff);
+    printf("[STATS] Inference-%d took %.2fms\n" , m_instId, diff);
     
     start = TI_EDGEAI_GET_TIME();
     (*m_postProcObj)(originalBuff,m_inferOutputBuff);
@@ -252,6 +303,17 @@ InferencePipe::~InferencePipe()
     delete m_inferer;
     delete m_postProcObj;
 
+    /* Return the tensor buffers to the pool for reuse. */
+    for (auto *t : m_inferInputBuff)
+    {
+        delete t;
+    }
+
+    for (auto *t : m_inferOutputBuff)
+    {
+        delete t;
+    }
+
     m_inferInputBuff.clear();
     m_inferOutputBuff.clear();
 }
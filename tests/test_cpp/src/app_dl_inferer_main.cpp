@@ -99,6 +99,11 @@ int32_t main(int argc, char * argv[])
     {
         DLInferer  *inferer;
 
+        if (cmdArgs.nullInferer)
+        {
+            infConfig.rtType = DL_INFER_RTTYPE_NULL;
+        }
+
         inferer = DLInferer::makeInferer(infConfig);
 
         if (inferer == nullptr)
@@ -204,7 +209,7 @@ int32_t main(int argc, char * argv[])
             inBuff = (void*)(preProcImage.data);
             ogBuff = (void*)(nv12Image.data);
 
-            inferPipe->runModel(inBuff,ogBuff);
+            inferPipe->runModel(inBuff,ogBuff,preProcImage.step);
 
             string imgName = postProcCfg.taskType
                             + "_output"
@@ -66,11 +66,14 @@ void preProcessImage(cv::Mat               &testImage,
         int32_t yMin = y_boundary;
         int32_t yMax = preProcCfg.resizeHeight-y_boundary;
 
-        resizedImage(cv::Rect(xMin,yMin,xMax-xMin,yMax-yMin)).copyTo(preProcImage);
+        /* Keep a view of the crop region. The rows are read with the
+         * pitch of the resized image during normalization.
+         */
+        preProcImage = resizedImage(cv::Rect(xMin,yMin,xMax-xMin,yMax-yMin));
     }
     else
     {
-        resizedImage.copyTo(preProcImage);
+        preProcImage = resizedImage;
     }
 }
 
@@ -0,0 +1,227 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/* Module headers. */
+#include <ti_null_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+static cpu_set_t getAffinity(pthread_t thread)
+{
+    cpu_set_t   set;
+
+    CPU_ZERO(&set);
+    pthread_getaffinity_np(thread, sizeof(set), &set);
+
+    return set;
+}
+
+static bool isOnlyCore(const cpu_set_t &set, int32_t core)
+{
+    return (CPU_COUNT(&set) == 1) && CPU_ISSET(core, &set);
+}
+
+/* Returns the last core the process may run on. */
+static int32_t pickCore()
+{
+    cpu_set_t   set = getAffinity(pthread_self());
+    int32_t     core = -1;
+
+    for (int32_t c = 0; c < CPU_SETSIZE; c++)
+    {
+        if (CPU_ISSET(c, &set))
+        {
+            core = c;
+        }
+    }
+
+    return core;
+}
+
+static NullInfererSpec makeSpec()
+{
+    NullInfererSpec spec;
+
+    spec.inputs    = {{"input", "float32", {1, 3, 8, 8}}};
+    spec.outputs   = {{"output", "float32", {1, 10}}};
+    spec.latencyMs = 200;
+
+    return spec;
+}
+
+/* The scope restricts the thread and restores it afterwards. */
+static int32_t testScope(int32_t core)
+{
+    cpu_set_t   saved = getAffinity(pthread_self());
+
+    {
+        DlCpuAffinityScope  affinity({core});
+
+        TEST_CHECK(isOnlyCore(getAffinity(pthread_self()), core));
+    }
+
+    cpu_set_t   after = getAffinity(pthread_self());
+
+    TEST_CHECK(CPU_EQUAL(&saved, &after));
+
+    {
+        DlCpuAffinityScope  affinity({});
+
+        after = getAffinity(pthread_self());
+        TEST_CHECK(CPU_EQUAL(&saved, &after));
+    }
+
+    return 0;
+}
+
+/* The thread calling run() is restricted during the call only. */
+static int32_t checkRun(DLInferer &inferer, int32_t core)
+{
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    atomic<int32_t> status{-1};
+    atomic<bool>    restored{false};
+
+    inferer.createBuffers(inferer.getInputInfo(), inputs, true);
+    inferer.createBuffers(inferer.getOutputInfo(), outputs, true);
+
+    thread runner([&]{
+        cpu_set_t   before = getAffinity(pthread_self());
+
+        status = inferer.run(inputs, outputs);
+
+        cpu_set_t   after = getAffinity(pthread_self());
+
+        restored = CPU_EQUAL(&before, &after);
+    });
+
+    /* The run sleeps for the simulated latency. */
+    this_thread::sleep_for(chrono::milliseconds(100));
+    bool pinned = isOnlyCore(getAffinity(runner.native_handle()), core);
+
+    runner.join();
+    deleteTensors(inputs);
+    deleteTensors(outputs);
+
+    TEST_CHECK(pinned);
+    TEST_CHECK(status == 0);
+    TEST_CHECK(restored);
+
+    return 0;
+}
+
+static int32_t testSetAffinity(int32_t core)
+{
+    NullInferer     inferer(makeSpec());
+
+    inferer.setCpuAffinity({core});
+
+    return checkRun(inferer, core);
+}
+
+static int32_t testConfigAffinity(int32_t core)
+{
+    InfererConfig   config;
+    DLInferer      *inferer;
+    int32_t         status;
+
+    config.rtType                = DL_INFER_RTTYPE_NULL;
+    config.nullSpec              = makeSpec();
+    config.cpuTuning.cpuAffinity = {core};
+
+    inferer = DLInferer::makeInferer(config);
+    TEST_CHECK(inferer != nullptr);
+
+    status = checkRun(*inferer, core);
+
+    delete inferer;
+
+    return status;
+}
+
+int main()
+{
+    int32_t core = pickCore();
+    int32_t status = 0;
+
+    if (core < 0)
+    {
+        printf("[%s:%d] No core to run on.\n", __FUNCTION__, __LINE__);
+        return 1;
+    }
+
+    status |= testScope(core);
+    status |= testSetAffinity(core);
+    status |= testConfigAffinity(core);
+
+    return reportStatus(status);
+}
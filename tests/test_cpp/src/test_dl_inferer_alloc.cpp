@@ -0,0 +1,402 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdlib.h>
+#include <errno.h>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(USE_ONNX_RT)
+#include <core/session/onnxruntime_cxx_api.h>
+#endif // defined(USE_ONNX_RT)
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+#include <ti_dl_inferer_config.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* Number of runs counted per window. */
+#define TEST_NUM_ITER   (2000)
+
+/* Heap allocation counter. The allocator entry points are interposed for
+ * the whole process and forward to glibc. operator new goes through
+ * malloc().
+ */
+extern "C"
+{
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t num, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t align, size_t size);
+}
+
+static atomic<bool>     gCountAllocs{false};
+static atomic<uint64_t> gNumAllocs{0};
+
+static inline void countAlloc()
+{
+    if (gCountAllocs.load(memory_order_relaxed))
+    {
+        gNumAllocs.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+extern "C" void *malloc(size_t size)
+{
+    countAlloc();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t num, size_t size)
+{
+    countAlloc();
+    return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    countAlloc();
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void *memalign(size_t align, size_t size)
+{
+    countAlloc();
+    return __libc_memalign(align, size);
+}
+
+extern "C" void *aligned_alloc(size_t align, size_t size)
+{
+    countAlloc();
+    return __libc_memalign(align, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t align, size_t size)
+{
+    countAlloc();
+    *ptr = __libc_memalign(align, size);
+    return (*ptr == nullptr) ? ENOMEM : 0;
+}
+
+/* Allocations made by a window of runs. */
+struct AllocCounts
+{
+    /** Runs on the buffers given to registerBuffers(). */
+    uint64_t    registered{};
+
+    /** Runs on explicit buffers. */
+    uint64_t    explicitRuns{};
+};
+
+/* Warms the inferer up then counts the allocations of both run() flavours.
+ * The warm-up runs set up the bindings, grow the buffers and let the
+ * shapes of the dynamic outputs settle.
+ */
+static int32_t countRunAllocs(DLInferer         &inferer,
+                              const string      &rtType,
+                              VecDlTensorPtr    &inputs,
+                              VecDlTensorPtr    &outputs,
+                              AllocCounts       &counts)
+{
+    int32_t status;
+
+    status = inferer.registerBuffers(inputs, outputs);
+
+    for (int32_t i = 0; (status == 0) && (i < 3); i++)
+    {
+        status = inferer.run();
+    }
+
+    TEST_CHECK(status == 0);
+
+    gNumAllocs   = 0;
+    gCountAllocs = true;
+
+    for (int32_t i = 0; (status == 0) && (i < TEST_NUM_ITER); i++)
+    {
+        status = inferer.run();
+    }
+
+    gCountAllocs      = false;
+    counts.registered = gNumAllocs;
+    TEST_CHECK(status == 0);
+
+    for (int32_t i = 0; (status == 0) && (i < 3); i++)
+    {
+        status = inferer.run(inputs, outputs);
+    }
+
+    gNumAllocs   = 0;
+    gCountAllocs = true;
+
+    for (int32_t i = 0; (status == 0) && (i < TEST_NUM_ITER); i++)
+    {
+        status = inferer.run(inputs, outputs);
+    }
+
+    gCountAllocs        = false;
+    counts.explicitRuns = gNumAllocs;
+    TEST_CHECK(status == 0);
+
+    printf("%-10s run(): %lu allocations, run(in, out): %lu allocations "
+           "over %d runs\n", rtType.c_str(),
+           counts.registered, counts.explicitRuns, TEST_NUM_ITER);
+
+    return 0;
+}
+
+#if defined(USE_ONNX_RT)
+static ONNXTensorElementDataType toOrtType(DlInferType type)
+{
+    switch (type)
+    {
+        case DlInferType_Int8:      return ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8;
+        case DlInferType_UInt8:     return ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8;
+        case DlInferType_Int16:     return ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16;
+        case DlInferType_UInt16:    return ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16;
+        case DlInferType_Int32:     return ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32;
+        case DlInferType_UInt32:    return ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32;
+        case DlInferType_Int64:     return ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
+        case DlInferType_Float16:   return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+        case DlInferType_Float32:   return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+        default:                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+    }
+}
+
+/* Allocations made by ONNX Runtime itself for a window of runs, measured
+ * on a bare session set up like the inferer one and bound to the same
+ * buffers. Session::Run() allocates its execution frame on every call.
+ */
+static int32_t countOrtAllocs(const InfererConfig   &config,
+                              VecDlTensorPtr        &inputs,
+                              VecDlTensorPtr        &outputs,
+                              uint64_t              &numAllocs)
+{
+    Ort::Env            env(ORT_LOGGING_LEVEL_ERROR, "test_dl_inferer_alloc");
+    Ort::SessionOptions opts;
+    Ort::RunOptions     runOpts;
+    Ort::MemoryInfo     memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator,
+                                                             OrtMemTypeDefault);
+    vector<Ort::Value>  values;
+
+    opts.SetIntraOpNumThreads(1);
+    opts.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+
+    Ort::Session        session(env, config.modelFile.c_str(), opts);
+    Ort::IoBinding      binding(session);
+
+    for (auto *t : inputs)
+    {
+        values.push_back(Ort::Value::CreateTensor(memInfo, t->data, t->size,
+                                                  t->shape.data(),
+                                                  t->shape.size(),
+                                                  toOrtType(t->type)));
+        binding.BindInput(t->name, values.back());
+    }
+
+    for (auto *t : outputs)
+    {
+        values.push_back(Ort::Value::CreateTensor(memInfo, t->data, t->size,
+                                                  t->shape.data(),
+                                                  t->shape.size(),
+                                                  toOrtType(t->type)));
+        binding.BindOutput(t->name, values.back());
+    }
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        session.Run(runOpts, binding);
+    }
+
+    gNumAllocs   = 0;
+    gCountAllocs = true;
+
+    for (int32_t i = 0; i < TEST_NUM_ITER; i++)
+    {
+        session.Run(runOpts, binding);
+    }
+
+    gCountAllocs = false;
+    numAllocs    = gNumAllocs;
+
+    printf("%-10s session: %lu allocations over %d runs\n",
+           DL_INFER_RTTYPE_ONNX, numAllocs, TEST_NUM_ITER);
+
+    return 0;
+}
+#endif // defined(USE_ONNX_RT)
+
+/* Steady state runs of the inferer layer do not allocate. For ONNX Runtime,
+ * which allocates inside Session::Run(), the runs may not allocate more
+ * than the bare session.
+ */
+static int32_t testConfig(const InfererConfig &config)
+{
+    DLInferer      *inferer;
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    AllocCounts     counts;
+    uint64_t        budget = 0;
+    int32_t         status;
+
+    inferer = DLInferer::makeInferer(config);
+    TEST_CHECK(inferer != nullptr);
+
+    inferer->createBuffers(inferer->getInputInfo(), inputs, true);
+    inferer->createBuffers(inferer->getOutputInfo(), outputs, true);
+
+    for (auto *t : inputs)
+    {
+        memset(t->data, 0, t->size);
+    }
+
+    status = countRunAllocs(*inferer, config.rtType, inputs, outputs, counts);
+
+#if defined(USE_ONNX_RT)
+    if ((status == 0) && (config.rtType == DL_INFER_RTTYPE_ONNX))
+    {
+        status = countOrtAllocs(config, inputs, outputs, budget);
+    }
+#endif // defined(USE_ONNX_RT)
+
+    delete inferer;
+    deleteTensors(inputs);
+    deleteTensors(outputs);
+
+    TEST_CHECK(status == 0);
+    TEST_CHECK(counts.registered <= budget);
+    TEST_CHECK(counts.explicitRuns <= budget);
+
+    return 0;
+}
+
+static int32_t testNullInferer()
+{
+    InfererConfig   config;
+
+    config.rtType           = DL_INFER_RTTYPE_NULL;
+    config.nullSpec.inputs  = {{"input", "float32", {1, 3, 32, 32}}};
+    config.nullSpec.outputs = {{"boxes", "float32", {1, 100, 4}},
+                               {"scores", "float32", {1, 100}}};
+
+    return testConfig(config);
+}
+
+/* Models of the enabled runtimes, given as model directories on the command
+ * line or in the colon separated TEST_DL_INFERER_MODELS variable. TIDL is
+ * not used so that the runs are deterministic.
+ */
+static int32_t testModels(int argc, char *argv[])
+{
+    vector<string>  modelDirs(argv + 1, argv + argc);
+    const char     *env = getenv("TEST_DL_INFERER_MODELS");
+
+    if (modelDirs.empty() && (env != nullptr))
+    {
+        stringstream    ss(env);
+        string          dir;
+
+        while (getline(ss, dir, ':'))
+        {
+            if (!dir.empty())
+            {
+                modelDirs.push_back(dir);
+            }
+        }
+    }
+
+    if (modelDirs.empty())
+    {
+        printf("No model given, only the null backend is tested.\n");
+    }
+
+    for (const auto &dir : modelDirs)
+    {
+        InfererConfig   config;
+
+        TEST_CHECK(config.getConfig(dir, false) == 0);
+        TEST_CHECK(testConfig(config) == 0);
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int32_t status;
+
+    status = testNullInferer();
+
+    if (status == 0)
+    {
+        status = testModels(argc, argv);
+    }
+
+    return reportStatus(status);
+}
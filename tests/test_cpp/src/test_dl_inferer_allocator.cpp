@@ -0,0 +1,290 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdint.h>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/* Module headers. */
+#include <ti_dl_inferer_allocator.h>
+#include <ti_dl_inferer_buffer_pool.h>
+#include <ti_null_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* Forwards to another allocator and tracks the buffers it hands out. */
+class CountingAllocator: public DlAllocator
+{
+    public:
+        CountingAllocator(const shared_ptr<DlAllocator> &inner):
+            m_inner(inner)
+        {
+        }
+
+        virtual void *allocate(int64_t size, int32_t alignment) override
+        {
+            void                   *ptr = m_inner->allocate(size, alignment);
+            lock_guard<mutex>       lock(m_mutex);
+
+            if (ptr != nullptr)
+            {
+                m_live[ptr] = size;
+                numAllocs++;
+            }
+
+            return ptr;
+        }
+
+        virtual void free(void *ptr, int64_t size) override
+        {
+            lock_guard<mutex>       lock(m_mutex);
+            auto                    it = m_live.find(ptr);
+
+            /* Freed once, with the size it was allocated with. */
+            if ((it == m_live.end()) || (it->second != size))
+            {
+                numBadFrees++;
+            }
+            else
+            {
+                m_live.erase(it);
+            }
+
+            numFrees++;
+            m_inner->free(ptr, size);
+        }
+
+        virtual int32_t getAlignment() const override
+        {
+            return m_inner->getAlignment();
+        }
+
+        virtual int64_t getAllocSize(int64_t size) const override
+        {
+            return m_inner->getAllocSize(size);
+        }
+
+        virtual const char *getName() const override
+        {
+            return m_inner->getName();
+        }
+
+        uint64_t numLive()
+        {
+            lock_guard<mutex>       lock(m_mutex);
+
+            return m_live.size();
+        }
+
+        uint64_t    numAllocs{};
+        uint64_t    numFrees{};
+        uint64_t    numBadFrees{};
+
+    private:
+        shared_ptr<DlAllocator>     m_inner;
+        mutex                       m_mutex;
+        map<void *, int64_t>        m_live;
+};
+
+static bool isAligned(const void *ptr, int32_t alignment)
+{
+    return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+
+/* A buffer goes to the allocator once, is reused from the pool after being
+ * released, and is freed with its allocation size on trim(), after which
+ * the pool no longer holds the allocator.
+ */
+static int32_t testPoolRoundTrip(const string &name)
+{
+    DlBufferPool                   &pool = DlBufferPool::getInstance();
+    shared_ptr<DlAllocator>         inner = DlAllocator::makeAllocator(name);
+    shared_ptr<CountingAllocator>   alloc;
+    DlBufferPoolStats               base;
+    DlBufferPoolStats               stats;
+    int64_t                         bytes;
+    void                           *ptr;
+
+    TEST_CHECK(inner != nullptr);
+    TEST_CHECK(name == inner->getName());
+
+    alloc = make_shared<CountingAllocator>(inner);
+    pool.trim();
+    base = pool.getStats();
+
+    ptr = pool.allocate(1000, 64, alloc);
+    TEST_CHECK(ptr != nullptr);
+    TEST_CHECK(isAligned(ptr, 64));
+    memset(ptr, 0xa5, 1000);
+
+    /* The pool accounts for the memory the allocator actually takes. */
+    stats = pool.getStats();
+    bytes = stats.inUseBytes - base.inUseBytes;
+
+    TEST_CHECK(alloc->numAllocs == 1);
+    TEST_CHECK(bytes >= 1000);
+    TEST_CHECK(inner->getAllocSize(bytes) == bytes);
+    TEST_CHECK(alloc.use_count() > 1);
+
+    if (name == "memfd")
+    {
+        TEST_CHECK(static_pointer_cast<DlMemfdAllocator>(inner)->getFd(ptr) >= 0);
+    }
+
+    pool.release(ptr);
+    stats = pool.getStats();
+    TEST_CHECK(stats.cachedBytes - base.cachedBytes == bytes);
+    TEST_CHECK(stats.inUseBytes == base.inUseBytes);
+
+    TEST_CHECK(pool.allocate(1000, 64, alloc) == ptr);
+    TEST_CHECK(alloc->numAllocs == 1);
+    TEST_CHECK(pool.getStats().hits == base.hits + 1);
+
+    /* Another allocator never gets the cached buffer. */
+    void   *other = pool.allocate(1000, 64);
+
+    TEST_CHECK((other != nullptr) && (other != ptr));
+    pool.release(other);
+
+    pool.release(ptr);
+    TEST_CHECK(alloc->numFrees == 0);
+
+    pool.trim();
+    TEST_CHECK(alloc->numFrees == 1);
+    TEST_CHECK(alloc->numBadFrees == 0);
+    TEST_CHECK(alloc->numLive() == 0);
+    TEST_CHECK(alloc.use_count() == 1);
+
+    stats = pool.getStats();
+    TEST_CHECK((stats.cachedBytes == 0) && (stats.numInUse == base.numInUse));
+
+    return 0;
+}
+
+/* The buffers created through an inferer come from its allocator. */
+static int32_t testInfererRoundTrip(const string &name)
+{
+    NullInfererSpec                 spec;
+    shared_ptr<CountingAllocator>   alloc;
+    VecDlTensorPtr                  inputs;
+    VecDlTensorPtr                  outputs;
+
+    spec.inputs  = {{"input", "float32", {1, 3, 64, 64}}};
+    spec.outputs = {{"boxes", "float32", {1, 100, 4}},
+                    {"scores", "float32", {1, 100}}};
+
+    alloc = make_shared<CountingAllocator>(DlAllocator::makeAllocator(name));
+
+    {
+        NullInferer     inferer(spec);
+
+        inferer.setAllocator(alloc);
+        TEST_CHECK(inferer.getAllocator() == alloc);
+
+        TEST_CHECK(inferer.createBuffers(inferer.getInputInfo(), inputs, true) == 0);
+        TEST_CHECK(inferer.createBuffers(inferer.getOutputInfo(), outputs, true) == 0);
+        TEST_CHECK(alloc->numAllocs == 3);
+        TEST_CHECK(inferer.run(inputs, outputs) == 0);
+
+        deleteTensors(inputs);
+        deleteTensors(outputs);
+
+        /* Recreating the buffers reuses the cached ones. */
+        TEST_CHECK(inferer.createBuffers(inferer.getInputInfo(), inputs, true) == 0);
+        TEST_CHECK(inferer.createBuffers(inferer.getOutputInfo(), outputs, true) == 0);
+        TEST_CHECK(alloc->numAllocs == 3);
+
+        deleteTensors(inputs);
+        deleteTensors(outputs);
+    }
+
+    DlBufferPool::getInstance().trim();
+    TEST_CHECK(alloc->numFrees == 3);
+    TEST_CHECK(alloc->numBadFrees == 0);
+    TEST_CHECK(alloc.use_count() == 1);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    if (DlAllocator::makeAllocator("unknown") != nullptr)
+    {
+        status = -1;
+    }
+
+    for (const char *name : {"default", "hugepage", "memfd"})
+    {
+        status |= testPoolRoundTrip(name);
+        status |= testInfererRoundTrip(name);
+    }
+
+    return reportStatus(status);
+}
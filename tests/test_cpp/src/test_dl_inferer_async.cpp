@@ -0,0 +1,313 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_allocator.h>
+#include <ti_null_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* Heap allocator failing once a number of allocations succeeded. */
+class FailingAllocator: public DlAllocator
+{
+    public:
+        FailingAllocator(int32_t numAllowed):
+            m_numAllowed(numAllowed)
+        {
+        }
+
+        virtual void *allocate(int64_t size, int32_t alignment) override
+        {
+            if (m_numAllowed-- <= 0)
+            {
+                return nullptr;
+            }
+
+            return aligned_alloc(alignment, size);
+        }
+
+        virtual void free(void *ptr, int64_t /*size*/) override
+        {
+            ::free(ptr);
+        }
+
+        virtual int32_t getAlignment() const override
+        {
+            return 64;
+        }
+
+        virtual const char *getName() const override
+        {
+            return "failing";
+        }
+
+    private:
+        std::atomic<int32_t>    m_numAllowed;
+};
+
+static NullInfererSpec makeSpec(float latencyMs)
+{
+    NullInfererSpec spec;
+
+    spec.inputs    = {{"input", "float32", {1, 3, 8, 8}}};
+    spec.outputs   = {{"output", "float32", {1, 10}}};
+    spec.fill      = "logits";
+    spec.numClasses = 10;
+    spec.latencyMs = latencyMs;
+
+    return spec;
+}
+
+/* The requests complete in submission order, each on its own buffer set. */
+static int32_t testOrdering()
+{
+    const int32_t       numRequests = 32;
+    NullInferer         inferer(makeSpec(0.2f));
+    vector<int32_t>     order;
+    mutex               orderMutex;
+    vector<future<int32_t>> futures;
+
+    TEST_CHECK(inferer.createBufferRing(3) == 0);
+
+    for (int32_t i = 0; i < numRequests; i++)
+    {
+        DlBufferSet *set = inferer.acquireBufferSet();
+
+        TEST_CHECK(set != nullptr);
+
+        futures.push_back(inferer.runAsync(set->inputs, set->outputs,
+            [&, i, set](int32_t, const VecDlTensorPtr &, VecDlTensorPtr &)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(orderMutex);
+                    order.push_back(i);
+                }
+
+                inferer.releaseBufferSet(set);
+            }));
+    }
+
+    inferer.waitAsync();
+
+    for (auto &f : futures)
+    {
+        TEST_CHECK(f.get() == 0);
+    }
+
+    TEST_CHECK(order.size() == (size_t)numRequests);
+
+    for (int32_t i = 0; i < numRequests; i++)
+    {
+        TEST_CHECK(order[i] == i);
+    }
+
+    return 0;
+}
+
+/* Acquiring from an exhausted ring blocks until a set is released. */
+static int32_t testExhaustion()
+{
+    NullInferer         inferer(makeSpec(0.0f));
+    DlBufferSet        *set0;
+    DlBufferSet        *set1;
+    DlBufferSet        *set2 = nullptr;
+    atomic<bool>        acquired{false};
+
+    TEST_CHECK(inferer.createBufferRing(2) == 0);
+
+    set0 = inferer.acquireBufferSet();
+    set1 = inferer.acquireBufferSet();
+    TEST_CHECK((set0 != nullptr) && (set1 != nullptr) && (set0 != set1));
+
+    thread waiter([&]{
+        set2 = inferer.acquireBufferSet();
+        acquired = true;
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(50));
+    TEST_CHECK(!acquired);
+
+    TEST_CHECK(inferer.releaseBufferSet(set1) == 0);
+    waiter.join();
+    TEST_CHECK(acquired && (set2 == set1));
+
+    TEST_CHECK(inferer.releaseBufferSet(set0) == 0);
+    TEST_CHECK(inferer.releaseBufferSet(set2) == 0);
+
+    return 0;
+}
+
+/* Foreign and double releases are rejected, and the ring cannot be rebuilt
+ * while a set is out.
+ */
+static int32_t testMisuse()
+{
+    NullInferer         inferer(makeSpec(0.0f));
+    NullInferer         other(makeSpec(0.0f));
+    DlBufferSet        *set;
+    DlBufferSet        *otherSet;
+
+    TEST_CHECK(inferer.releaseBufferSet(nullptr) < 0);
+
+    TEST_CHECK(inferer.createBufferRing(2) == 0);
+    TEST_CHECK(other.createBufferRing(1) == 0);
+
+    set      = inferer.acquireBufferSet();
+    otherSet = other.acquireBufferSet();
+
+    TEST_CHECK(inferer.createBufferRing(4) < 0);
+    TEST_CHECK(inferer.releaseBufferSet(otherSet) < 0);
+    TEST_CHECK(inferer.releaseBufferSet(set) == 0);
+    TEST_CHECK(inferer.releaseBufferSet(set) < 0);
+    TEST_CHECK(other.releaseBufferSet(otherSet) == 0);
+
+    TEST_CHECK(inferer.createBufferRing(4) == 0);
+
+    return 0;
+}
+
+/* A ring whose buffers cannot all be allocated is not left half built. */
+static int32_t testPartialRing()
+{
+    NullInferer         inferer(makeSpec(0.0f));
+
+    /* Enough for one set of one input and one output. */
+    inferer.setAllocator(std::make_shared<FailingAllocator>(2));
+
+    TEST_CHECK(inferer.createBufferRing(3) < 0);
+    TEST_CHECK(inferer.acquireBufferSet() == nullptr);
+
+    return 0;
+}
+
+/* A run throwing something else than a std::exception fails its request
+ * only.
+ */
+class ThrowingInferer: public NullInferer
+{
+    public:
+        using NullInferer::NullInferer;
+
+        virtual int32_t run(const VecDlTensorPtr &inputs,
+                            VecDlTensorPtr       &outputs) override
+        {
+            if (m_numRuns++ == 0)
+            {
+                throw 42;
+            }
+
+            return NullInferer::run(inputs, outputs);
+        }
+
+        ~ThrowingInferer()
+        {
+            stopAsync();
+        }
+
+    private:
+        int32_t m_numRuns{0};
+};
+
+static int32_t testNonStdThrow()
+{
+    ThrowingInferer     inferer(makeSpec(0.0f));
+    VecDlTensorPtr      inputs;
+    VecDlTensorPtr      outputs;
+
+    TEST_CHECK(inferer.createBuffers(inferer.getInputInfo(), inputs, true) == 0);
+    TEST_CHECK(inferer.createBuffers(inferer.getOutputInfo(), outputs, true) == 0);
+
+    auto f0 = inferer.runAsync(inputs, outputs);
+    auto f1 = inferer.runAsync(inputs, outputs);
+
+    TEST_CHECK(f0.get() < 0);
+    TEST_CHECK(f1.get() == 0);
+
+    deleteTensors(inputs);
+    deleteTensors(outputs);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testOrdering();
+    status |= testExhaustion();
+    status |= testMisuse();
+    status |= testPartialRing();
+    status |= testNonStdThrow();
+
+    return reportStatus(status);
+}
@@ -0,0 +1,272 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <cstring>
+#include <vector>
+
+/* Module headers. */
+#include <ti_null_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+#define NUM_FRAMES      (4)
+#define FRAME_SIZE      (3*4*4)
+
+/* An identity model with a dynamic batch size. */
+static NullInfererSpec makeSpec()
+{
+    NullInfererSpec spec;
+
+    spec.inputs  = {{"input", "uint8", {-1, 3, 4, 4}}};
+    spec.outputs = {{"output", "uint8", {1, FRAME_SIZE}}};
+    spec.fill    = "echo";
+
+    return spec;
+}
+
+/* Creates the frames, filled with a pattern specific to each. The frame
+ * 'stridedFrame' points into 'pitched' with a row pitch of 6 elements.
+ */
+static int32_t makeFrames(DLInferer                    &inferer,
+                          vector<VecDlTensorPtr>       &inputs,
+                          vector<VecDlTensorPtr>       &outputs,
+                          vector<uint8_t>              &pitched,
+                          int32_t                       stridedFrame)
+{
+    inputs.resize(NUM_FRAMES);
+    outputs.resize(NUM_FRAMES);
+
+    for (int32_t b = 0; b < NUM_FRAMES; b++)
+    {
+        TEST_CHECK(inferer.createBuffers(inferer.getInputInfo(), inputs[b], true) == 0);
+        TEST_CHECK(inferer.createBuffers(inferer.getOutputInfo(), outputs[b], true) == 0);
+
+        DlTensor   *t = inputs[b][0];
+
+        if (b == stridedFrame)
+        {
+            pitched.assign(3*4*6, 0xff);
+            t->reshape({1, 3, 4, 4}, inferer);
+            t->strides = {3*4*6, 4*6, 6, 1};
+            TEST_CHECK(t->wrap(pitched.data(), pitched.size()) == 0);
+
+            for (int32_t k = 0; k < FRAME_SIZE; k++)
+            {
+                pitched[(k / 4) * 6 + (k % 4)] = b * 50 + k;
+            }
+        }
+        else
+        {
+            t->reshape({1, 3, 4, 4}, inferer);
+            TEST_CHECK(t->data != nullptr);
+
+            for (int32_t k = 0; k < FRAME_SIZE; k++)
+            {
+                reinterpret_cast<uint8_t *>(t->data)[k] = b * 50 + k;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static void deleteFrames(vector<VecDlTensorPtr> &frames)
+{
+    for (auto &f : frames)
+    {
+        deleteTensors(f);
+    }
+}
+
+/* Each frame gets back the output of its own input. */
+static int32_t checkOutputs(const vector<VecDlTensorPtr> &outputs)
+{
+    for (int32_t b = 0; b < NUM_FRAMES; b++)
+    {
+        const DlTensor *t = outputs[b][0];
+        const uint8_t  *p = reinterpret_cast<const uint8_t *>(t->data);
+
+        TEST_CHECK((p != nullptr) && (t->size == FRAME_SIZE));
+        TEST_CHECK((t->shape == vector<int64_t>{1, FRAME_SIZE}));
+
+        for (int32_t k = 0; k < FRAME_SIZE; k++)
+        {
+            TEST_CHECK(p[k] == (uint8_t)(b * 50 + k));
+        }
+    }
+
+    return 0;
+}
+
+/* The frames, a strided one included, are packed and scattered back. */
+static int32_t testPackScatter()
+{
+    NullInferer             inferer(makeSpec());
+    vector<VecDlTensorPtr>  inputs;
+    vector<VecDlTensorPtr>  outputs;
+    vector<uint8_t>         pitched;
+    int32_t                 status;
+
+    TEST_CHECK(makeFrames(inferer, inputs, outputs, pitched, 2) == 0);
+    TEST_CHECK(inferer.runBatch(inputs, outputs) == 0);
+
+    status = checkOutputs(outputs);
+
+    /* The frames run one by one give the same outputs. */
+    for (int32_t b = 0; (status == 0) && (b < NUM_FRAMES); b++)
+    {
+        memset(outputs[b][0]->data, 0, outputs[b][0]->size);
+        status = inferer.run(inputs[b], outputs[b]);
+    }
+
+    if (status == 0)
+    {
+        status = checkOutputs(outputs);
+    }
+
+    deleteFrames(inputs);
+    deleteFrames(outputs);
+
+    return status;
+}
+
+/* Missing and undersized output buffers get allocated. */
+static int32_t testOutputAllocation()
+{
+    NullInferer             inferer(makeSpec());
+    vector<VecDlTensorPtr>  inputs;
+    vector<VecDlTensorPtr>  outputs;
+    vector<uint8_t>         pitched;
+    uint8_t                 small[8];
+    int32_t                 status;
+
+    TEST_CHECK(makeFrames(inferer, inputs, outputs, pitched, -1) == 0);
+
+    outputs[1][0]->wrap(small, sizeof(small));
+    outputs[3][0]->data = nullptr;
+
+    TEST_CHECK(inferer.runBatch(inputs, outputs) == 0);
+    TEST_CHECK(outputs[1][0]->data != small);
+
+    status = checkOutputs(outputs);
+
+    deleteFrames(inputs);
+    deleteFrames(outputs);
+
+    return status;
+}
+
+/* Inconsistent frames are rejected before anything runs. */
+static int32_t testInvalidFrames()
+{
+    NullInferer             inferer(makeSpec());
+    vector<VecDlTensorPtr>  inputs;
+    vector<VecDlTensorPtr>  outputs;
+    vector<uint8_t>         pitched;
+    vector<VecDlTensorPtr>  fewer;
+    int32_t                 status = 0;
+
+    TEST_CHECK(makeFrames(inferer, inputs, outputs, pitched, -1) == 0);
+
+    fewer.assign(outputs.begin(), outputs.end() - 1);
+
+    if (inferer.runBatch(inputs, fewer) == 0)
+    {
+        status = -1;
+    }
+
+    inputs[1][0]->reshape({1, 3, 4, 2}, inferer);
+
+    if (inferer.runBatch(inputs, outputs) == 0)
+    {
+        status = -1;
+    }
+
+    inputs[1][0]->reshape({1, 3, 4, 4}, inferer);
+    inputs[2][0]->data = nullptr;
+
+    if (inferer.runBatch(inputs, outputs) == 0)
+    {
+        status = -1;
+    }
+
+    deleteFrames(inputs);
+    deleteFrames(outputs);
+
+    TEST_CHECK(status == 0);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testPackScatter();
+    status |= testOutputAllocation();
+    status |= testInvalidFrames();
+
+    return reportStatus(status);
+}
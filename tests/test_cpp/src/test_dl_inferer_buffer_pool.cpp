@@ -0,0 +1,205 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdint.h>
+#include <set>
+
+/* Module headers. */
+#include <ti_dl_inferer_buffer_pool.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+static bool isAligned(const void *ptr, int32_t alignment)
+{
+    return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+
+/* A released buffer serves the next request of the same bucket. */
+static int32_t testBucketReuse()
+{
+    DlBufferPool       &pool = DlBufferPool::getInstance();
+    DlBufferPoolStats   s0;
+    DlBufferPoolStats   s1;
+    void               *p;
+    void               *q;
+    void               *r;
+
+    pool.trim();
+    s0 = pool.getStats();
+
+    p = pool.allocate(1000, 64);
+    TEST_CHECK((p != nullptr) && isAligned(p, 64));
+
+    s1 = pool.getStats();
+    TEST_CHECK(s1.misses == s0.misses + 1);
+    TEST_CHECK(s1.numInUse == s0.numInUse + 1);
+    TEST_CHECK(s1.inUseBytes - s0.inUseBytes >= 1000);
+
+    pool.release(p);
+    s1 = pool.getStats();
+    TEST_CHECK(s1.numInUse == s0.numInUse);
+    TEST_CHECK(s1.inUseBytes == s0.inUseBytes);
+    TEST_CHECK(s1.cachedBytes > s0.cachedBytes);
+
+    /* A slightly larger size lands in the same bucket. */
+    q = pool.allocate(1010, 64);
+    TEST_CHECK(q == p);
+    TEST_CHECK(pool.getStats().hits == s0.hits + 1);
+    TEST_CHECK(pool.getStats().cachedBytes == s0.cachedBytes);
+
+    /* The bucket is empty while 'q' is out. */
+    r = pool.allocate(1000, 64);
+    TEST_CHECK((r != nullptr) && (r != q));
+    TEST_CHECK(pool.getStats().misses == s0.misses + 2);
+
+    pool.release(q);
+    pool.release(r);
+
+    /* A different alignment or a distant size does not reuse the bucket. */
+    p = pool.allocate(1000, 4096);
+    TEST_CHECK((p != q) && (p != r) && isAligned(p, 4096));
+
+    q = pool.allocate(100000, 64);
+    TEST_CHECK((q != r) && isAligned(q, 64));
+    TEST_CHECK(pool.getStats().hits == s0.hits + 1);
+
+    pool.release(p);
+    pool.release(q);
+
+    pool.trim();
+    TEST_CHECK(pool.getStats().cachedBytes == 0);
+    TEST_CHECK(pool.getStats().numInUse == s0.numInUse);
+
+    return 0;
+}
+
+/* The buckets are at most 25% larger than the requests. */
+static int32_t testBucketOverhead()
+{
+    DlBufferPool       &pool = DlBufferPool::getInstance();
+
+    for (int64_t size = 1000; size < 10000000; size = size * 3 + 17)
+    {
+        int64_t before = pool.getStats().inUseBytes;
+        void   *p = pool.allocate(size, 64);
+        int64_t bucket = pool.getStats().inUseBytes - before;
+
+        TEST_CHECK(p != nullptr);
+        TEST_CHECK((bucket >= size) && (bucket <= size + size / 4 + 64));
+
+        pool.release(p);
+    }
+
+    pool.trim();
+
+    return 0;
+}
+
+/* Buffers released beyond the cache limit are freed right away. */
+static int32_t testCacheLimit()
+{
+    DlBufferPool       &pool = DlBufferPool::getInstance();
+    set<void *>         ptrs;
+
+    pool.trim();
+    pool.setMaxCachedBytes(4096);
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        ptrs.insert(pool.allocate(2048, 64));
+    }
+
+    TEST_CHECK((ptrs.size() == 4) && (ptrs.count(nullptr) == 0));
+
+    for (auto *p : ptrs)
+    {
+        pool.release(p);
+    }
+
+    TEST_CHECK(pool.getStats().cachedBytes <= 4096);
+    TEST_CHECK(pool.getStats().cachedBytes > 0);
+
+    pool.setMaxCachedBytes(0);
+    TEST_CHECK(pool.getStats().cachedBytes == 0);
+
+    pool.setMaxCachedBytes(256*1024*1024);
+
+    /* Invalid requests fail without touching the counters. */
+    TEST_CHECK(pool.allocate(0, 64) == nullptr);
+    TEST_CHECK(pool.getStats().numInUse == 0);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testBucketReuse();
+    status |= testBucketOverhead();
+    status |= testCacheLimit();
+
+    return reportStatus(status);
+}
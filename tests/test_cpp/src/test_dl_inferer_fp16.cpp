@@ -0,0 +1,278 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_fp16.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+static uint32_t toBits(float f)
+{
+    uint32_t    bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static float fromBits(uint32_t bits)
+{
+    float   f;
+
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static bool isHalfNan(uint16_t h)
+{
+    return ((h & 0x7c00) == 0x7c00) && ((h & 0x3ff) != 0);
+}
+
+/* Value of a finite half precision bit pattern, from the definition. */
+static double halfValue(uint16_t h)
+{
+    int32_t exp = (h >> 10) & 0x1f;
+    int32_t man = h & 0x3ff;
+    double  v;
+
+    v = (exp == 0) ? ldexp(man, -24) : ldexp(1024 + man, exp - 25);
+
+    return (h & 0x8000) ? -v : v;
+}
+
+/* Same value, or both NaN with the same sign. */
+static bool sameFloat(float a, float b)
+{
+    if (std::isnan(a) || std::isnan(b))
+    {
+        return std::isnan(a) && std::isnan(b) &&
+               (std::signbit(a) == std::signbit(b));
+    }
+
+    return toBits(a) == toBits(b);
+}
+
+static bool sameHalf(uint16_t a, uint16_t b)
+{
+    if (isHalfNan(a) || isHalfNan(b))
+    {
+        return isHalfNan(a) && isHalfNan(b) && ((a & 0x8000) == (b & 0x8000));
+    }
+
+    return a == b;
+}
+
+/* The scalar widening matches the definition for every half value. */
+static int32_t testScalarToFp32()
+{
+    for (uint32_t h = 0; h < 0x10000; h++)
+    {
+        float   f = fp16ToFp32(h);
+
+        if ((h & 0x7c00) == 0x7c00)
+        {
+            TEST_CHECK(isHalfNan(h) ? std::isnan(f) : std::isinf(f));
+            TEST_CHECK(std::signbit(f) == ((h & 0x8000) != 0));
+        }
+        else
+        {
+            TEST_CHECK(f == halfValue(h));
+            TEST_CHECK(std::signbit(f) == ((h & 0x8000) != 0));
+        }
+    }
+
+    return 0;
+}
+
+/* The scalar narrowing returns the nearest half value, the even one on a
+ * tie, for a sweep of single precision values and all the half midpoints.
+ */
+static int32_t checkNarrowing(float f)
+{
+    uint16_t    h = fp32ToFp16(f);
+    double      err;
+
+    if (std::isnan(f))
+    {
+        TEST_CHECK(isHalfNan(h));
+        return 0;
+    }
+
+    if (fabs(f) >= 65520.0)
+    {
+        TEST_CHECK((h & 0x7fff) == 0x7c00);
+        TEST_CHECK(((h & 0x8000) != 0) == std::signbit(f));
+        return 0;
+    }
+
+    TEST_CHECK((h & 0x7c00) != 0x7c00);
+    TEST_CHECK(((h & 0x8000) != 0) == std::signbit(f));
+
+    err = fabs(f - halfValue(h));
+
+    /* Neighbours of the result, toward and away from zero. */
+    for (int32_t d = -1; d <= 1; d += 2)
+    {
+        uint16_t    n = (h & 0x8000) | ((h & 0x7fff) + d);
+
+        if (((h & 0x7fff) == 0) && (d < 0))
+        {
+            continue;
+        }
+
+        if ((n & 0x7c00) == 0x7c00)
+        {
+            continue;
+        }
+
+        double  nErr = fabs(f - halfValue(n));
+
+        TEST_CHECK(err <= nErr);
+        TEST_CHECK((err < nErr) || ((h & 1) == 0));
+    }
+
+    return 0;
+}
+
+static int32_t testScalarToFp16()
+{
+    for (uint64_t bits = 0; bits <= 0xffffffff; bits += 4099)
+    {
+        TEST_CHECK(checkNarrowing(fromBits(bits)) == 0);
+    }
+
+    for (uint32_t h = 0; h < 0x7bff; h++)
+    {
+        float   mid = (halfValue(h) + halfValue(h + 1)) / 2;
+
+        TEST_CHECK(checkNarrowing(mid) == 0);
+        TEST_CHECK(checkNarrowing(-mid) == 0);
+    }
+
+    TEST_CHECK(fp32ToFp16(1.0f) == 0x3c00);
+    TEST_CHECK(fp32ToFp16(65504.0f) == 0x7bff);
+    TEST_CHECK(fp32ToFp16(ldexp(1.0f, -24)) == 0x0001);
+    TEST_CHECK(fp32ToFp16(ldexp(1.0f, -25)) == 0x0000);
+    TEST_CHECK(fp32ToFp16(-0.0f) == 0x8000);
+
+    return 0;
+}
+
+/* The bulk routines match the scalar ones, whatever the length and the
+ * alignment of the arrays.
+ */
+static int32_t testBulk()
+{
+    vector<uint16_t>    half(0x10000 + 8);
+    vector<float>       single(0x10000 + 8);
+    vector<uint16_t>    halfOut(half.size());
+    vector<float>       singleOut(single.size());
+
+    for (uint32_t h = 0; h < half.size(); h++)
+    {
+        half[h] = h;
+    }
+
+    for (uint32_t i = 0; i < single.size(); i++)
+    {
+        /* Values around each half value, ties included. */
+        int32_t step = static_cast<int32_t>(i % 3) - 1;
+
+        single[i] = fp16ToFp32(i & 0xffff) * (1.0f + step * ldexp(1.0f, -11));
+    }
+
+    for (int64_t offset = 0; offset < 4; offset++)
+    {
+        for (int64_t count : {0L, 1L, 7L, 8L, 9L, 17L, 0x10000L})
+        {
+            convertFp16ToFp32(half.data() + offset, singleOut.data() + offset,
+                              count);
+            convertFp32ToFp16(single.data() + offset, halfOut.data() + offset,
+                              count);
+
+            for (int64_t i = offset; i < offset + count; i++)
+            {
+                TEST_CHECK(sameFloat(singleOut[i], fp16ToFp32(half[i])));
+                TEST_CHECK(sameHalf(halfOut[i], fp32ToFp16(single[i])));
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testScalarToFp32();
+    status |= testScalarToFp16();
+    status |= testBulk();
+
+    return reportStatus(status);
+}
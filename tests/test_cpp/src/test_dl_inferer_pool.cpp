@@ -0,0 +1,269 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_pool.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+static InfererConfig makeConfig()
+{
+    InfererConfig   config;
+
+    config.rtType               = DL_INFER_RTTYPE_NULL;
+    config.nullSpec.inputs      = {{"input", "float32", {1, 3, 8, 8}}};
+    config.nullSpec.outputs     = {{"output", "float32", {1, 10}}};
+    config.nullSpec.fill        = "logits";
+    config.nullSpec.numClasses  = 10;
+
+    return config;
+}
+
+/* Many threads contending for few instances never share one. */
+static int32_t testContention()
+{
+    const int32_t       numInstances = 3;
+    const int32_t       numThreads = 8;
+    const int32_t       numIters = 500;
+    InfererPool         pool(makeConfig(), numInstances);
+    vector<DLInferer *> inferers;
+    atomic<int32_t>     owners[numInstances];
+    atomic<int32_t>     numBusy{0};
+    atomic<int32_t>     maxBusy{0};
+    atomic<int32_t>     numErrors{0};
+    atomic<int32_t>     numDone{0};
+    vector<thread>      threads;
+
+    TEST_CHECK(pool.getNumInstances() == numInstances);
+
+    /* Learn the instances to map them to an index. */
+    for (int32_t i = 0; i < numInstances; i++)
+    {
+        inferers.push_back(pool.tryAcquire());
+        TEST_CHECK(inferers.back() != nullptr);
+        owners[i] = 0;
+    }
+
+    TEST_CHECK(pool.tryAcquire() == nullptr);
+
+    for (auto *inferer : inferers)
+    {
+        pool.release(inferer);
+    }
+
+    for (int32_t t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&]{
+            for (int32_t i = 0; i < numIters; i++)
+            {
+                DLInferer  *inferer = pool.acquire();
+                int32_t     idx = -1;
+                int32_t     busy;
+                int32_t     cur;
+
+                for (int32_t j = 0; j < numInstances; j++)
+                {
+                    if (inferers[j] == inferer)
+                    {
+                        idx = j;
+                    }
+                }
+
+                if ((idx < 0) || (owners[idx]++ != 0))
+                {
+                    numErrors++;
+                }
+
+                busy = ++numBusy;
+                cur  = maxBusy;
+
+                while ((busy > cur) && !maxBusy.compare_exchange_weak(cur, busy))
+                {
+                }
+
+                if ((i % 16) == 0)
+                {
+                    this_thread::yield();
+                }
+
+                numBusy--;
+
+                if (idx >= 0)
+                {
+                    owners[idx]--;
+                }
+
+                pool.release(inferer);
+                numDone++;
+            }
+        });
+    }
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    TEST_CHECK(numErrors == 0);
+    TEST_CHECK(numDone == numThreads * numIters);
+    TEST_CHECK((maxBusy >= 1) && (maxBusy <= numInstances));
+
+    /* All the instances are back. */
+    for (int32_t i = 0; i < numInstances; i++)
+    {
+        TEST_CHECK(pool.tryAcquire() != nullptr);
+    }
+
+    TEST_CHECK(pool.tryAcquire() == nullptr);
+
+    for (auto *inferer : inferers)
+    {
+        pool.release(inferer);
+    }
+
+    return 0;
+}
+
+/* acquire() sleeps until an instance is released. */
+static int32_t testBlockingAcquire()
+{
+    InfererPool         pool(makeConfig(), 1);
+    DLInferer          *inferer = pool.acquire();
+    DLInferer          *other = nullptr;
+    atomic<bool>        acquired{false};
+
+    TEST_CHECK(inferer != nullptr);
+
+    thread waiter([&]{
+        other = pool.acquire();
+        acquired = true;
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(50));
+    TEST_CHECK(!acquired);
+
+    pool.release(inferer);
+    waiter.join();
+
+    TEST_CHECK(acquired && (other == inferer));
+    pool.release(other);
+
+    return 0;
+}
+
+/* run() dispatches to any idle instance from many threads. */
+static int32_t testRun()
+{
+    InfererPool         pool(makeConfig(), 2);
+    vector<thread>      threads;
+    atomic<int32_t>     numErrors{0};
+
+    for (int32_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]{
+            VecDlTensorPtr  inputs;
+            VecDlTensorPtr  outputs;
+
+            pool.createBuffers(pool.getInputInfo(), inputs, true);
+            pool.createBuffers(pool.getOutputInfo(), outputs, true);
+
+            for (int32_t i = 0; i < 100; i++)
+            {
+                if (pool.run(inputs, outputs) != 0)
+                {
+                    numErrors++;
+                }
+            }
+
+            deleteTensors(inputs);
+            deleteTensors(outputs);
+        });
+    }
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    TEST_CHECK(numErrors == 0);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testContention();
+    status |= testBlockingAcquire();
+    status |= testRun();
+
+    return reportStatus(status);
+}
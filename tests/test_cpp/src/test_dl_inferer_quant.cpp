@@ -0,0 +1,259 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <cmath>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_quant.h>
+#include <ti_dl_inferer_fp16.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* Points a tensor description to test memory. */
+template <typename T>
+static void setTensor(DlTensor                 &t,
+                      DlInferType               type,
+                      vector<T>                &mem,
+                      const vector<int64_t>    &shape)
+{
+    t.type     = type;
+    t.elemSize = sizeof(T);
+    t.shape    = shape;
+    t.dim      = shape.size();
+    t.numElem  = mem.size();
+    t.size     = t.numElem * t.elemSize;
+    t.data     = mem.data();
+}
+
+/* Scalar reference of the dequantization. */
+static float refValue(float raw, float scale, int32_t zeroPoint)
+{
+    return (raw - zeroPoint) * scale;
+}
+
+/* The bulk 8 bit routines match the scalar reference for every stored
+ * value, whatever the length and the alignment of the arrays.
+ */
+static int32_t testBulk()
+{
+    vector<int8_t>  s8(256 + 64);
+    vector<uint8_t> u8(s8.size());
+    vector<float>   out(s8.size());
+    const float     scale = 0.0375f;
+    const int32_t   zeroPoint = 7;
+
+    for (uint32_t i = 0; i < s8.size(); i++)
+    {
+        s8[i] = static_cast<int8_t>(i * 37);
+        u8[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    for (int64_t offset = 0; offset < 4; offset++)
+    {
+        for (int64_t count : {0L, 1L, 15L, 16L, 17L, 33L, 256L})
+        {
+            dequantize(s8.data() + offset, out.data() + offset, count,
+                       scale, zeroPoint);
+
+            for (int64_t i = offset; i < offset + count; i++)
+            {
+                TEST_CHECK(out[i] == refValue(s8[i], scale, zeroPoint));
+            }
+
+            dequantize(u8.data() + offset, out.data() + offset, count,
+                       scale, zeroPoint);
+
+            for (int64_t i = offset; i < offset + count; i++)
+            {
+                TEST_CHECK(out[i] == refValue(u8[i], scale, zeroPoint));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Per-channel parameters follow the channel of each element, for the
+ * element wise and the range accessors.
+ */
+static int32_t testPerChannel()
+{
+    vector<int8_t>  mem(2 * 3 * 4 * 5);
+    vector<float>   out(mem.size());
+    DlTensor        t;
+
+    for (uint32_t i = 0; i < mem.size(); i++)
+    {
+        mem[i] = static_cast<int8_t>(i * 11 - 100);
+    }
+
+    setTensor(t, DlInferType_Int8, mem, {2, 3, 4, 5});
+    t.quant.scale     = {0.5f, 0.25f, 0.125f};
+    t.quant.zeroPoint = {-3, 0, 5};
+    t.quant.axis      = 1;
+
+    for (int64_t i = 0; i < t.numElem; i++)
+    {
+        int64_t ch = (i / 20) % 3;
+
+        TEST_CHECK(getRawValue(t, i) == mem[i]);
+        TEST_CHECK(getValue(t, i) ==
+                   refValue(mem[i], t.quant.scale[ch], t.quant.zeroPoint[ch]));
+    }
+
+    /* Ranges starting and ending inside a channel. */
+    for (int64_t begin : {0L, 7L, 20L, 59L})
+    {
+        for (int64_t count : {1L, 13L, 20L, 61L})
+        {
+            dequantize(t, begin, count, out.data());
+
+            for (int64_t i = 0; i < count; i++)
+            {
+                TEST_CHECK(out[i] == getValue(t, begin + i));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* The thresholds mapped to the stored values select the same elements,
+ * and the quantized values round to nearest and saturate.
+ */
+static int32_t testThresholds()
+{
+    vector<uint8_t> mem(256);
+    DlTensor        t;
+
+    for (uint32_t i = 0; i < mem.size(); i++)
+    {
+        mem[i] = i;
+    }
+
+    setTensor(t, DlInferType_UInt8, mem, {1, 256});
+    t.quant.scale     = {0.02f};
+    t.quant.zeroPoint = {128};
+
+    for (float threshold : {-2.51f, -0.013f, 0.0f, 0.3337f, 1.999f})
+    {
+        float   raw = quantizeThreshold(t, 0, threshold);
+
+        for (int64_t i = 0; i < t.numElem; i++)
+        {
+            TEST_CHECK((getRawValue(t, i) > raw) ==
+                       (getValue(t, i) > threshold));
+        }
+    }
+
+    TEST_CHECK(quantizeValue(t, 0, 0.0f) == 128);
+    TEST_CHECK(quantizeValue(t, 0, 0.5f) == 153);
+    TEST_CHECK(quantizeValue(t, 0, 0.509f) == 153);
+    TEST_CHECK(quantizeValue(t, 0, 100.0f) == 255);
+    TEST_CHECK(quantizeValue(t, 0, -100.0f) == 0);
+
+    return 0;
+}
+
+/* Tensors that are not quantized read as they are. */
+static int32_t testNotQuantized()
+{
+    vector<float>       f32 = {-1.5f, 0.0f, 3.25f};
+    vector<uint16_t>    f16 = {fp32ToFp16(-1.5f), 0, fp32ToFp16(3.25f)};
+    vector<float>       out(3);
+    DlTensor            t;
+    DlTensor            h;
+
+    setTensor(t, DlInferType_Float32, f32, {3});
+    setTensor(h, DlInferType_Float16, f16, {3});
+
+    dequantize(t, 0, 3, out.data());
+    TEST_CHECK(out == f32);
+
+    dequantize(h, 0, 3, out.data());
+    TEST_CHECK(out == f32);
+
+    for (int64_t i = 0; i < 3; i++)
+    {
+        TEST_CHECK(getValue(t, i) == f32[i]);
+        TEST_CHECK(getValue(h, i) == f32[i]);
+        TEST_CHECK(quantizeThreshold(t, i, 0.7f) == 0.7f);
+    }
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testBulk();
+    status |= testPerChannel();
+    status |= testThresholds();
+    status |= testNotQuantized();
+
+    return reportStatus(status);
+}
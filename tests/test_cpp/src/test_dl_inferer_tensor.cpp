@@ -0,0 +1,278 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_buffer_pool.h>
+#include <ti_null_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+static NullInfererSpec makeSpec()
+{
+    NullInfererSpec spec;
+
+    spec.inputs  = {{"input", "float32", {4, 3, 8, 8}}};
+    spec.outputs = {{"output", "float32", {1, 10}}};
+
+    return spec;
+}
+
+static uint64_t numInUse()
+{
+    return DlBufferPool::getInstance().getStats().numInUse;
+}
+
+/* The buffer goes back to the pool with its last owner. */
+static int32_t testShare()
+{
+    NullInferer     inferer(makeSpec());
+    uint64_t        base = numInUse();
+    DlTensor        t = inferer.getInputInfo()->at(0).cloneInfo();
+
+    TEST_CHECK(t.data == nullptr);
+
+    t.allocateDataBuffer(inferer);
+    TEST_CHECK(t.data != nullptr);
+    TEST_CHECK(numInUse() == base + 1);
+
+    {
+        DlTensor    s = t.share();
+
+        TEST_CHECK((s.data == t.data) && (s.size == t.size));
+        TEST_CHECK(s.getBuffer() == t.getBuffer());
+
+        /* A new buffer for 't' leaves the shared one to 's'. */
+        t.allocateDataBuffer(inferer);
+        TEST_CHECK(t.data != s.data);
+        TEST_CHECK(numInUse() == base + 2);
+    }
+
+    TEST_CHECK(numInUse() == base + 1);
+
+    {
+        DlTensor    s = t.share();
+        DlTensor    u = std::move(t);
+
+        /* The moved from tensor no longer holds anything. */
+        TEST_CHECK((t.data == nullptr) && (t.getBuffer() == nullptr));
+        TEST_CHECK(u.data == s.data);
+
+        t = std::move(u);
+        TEST_CHECK(numInUse() == base + 1);
+    }
+
+    TEST_CHECK(numInUse() == base + 1);
+
+    t = inferer.getInputInfo()->at(0).cloneInfo();
+    TEST_CHECK(numInUse() == base);
+
+    return 0;
+}
+
+/* The views point into the tensor without owning anything. */
+static int32_t testViews()
+{
+    NullInferer     inferer(makeSpec());
+    uint64_t        base = numInUse();
+    DlTensor        t = inferer.getInputInfo()->at(0).cloneInfo();
+    const uint8_t  *p;
+    bool            thrown = false;
+
+    t.allocateDataBuffer(inferer);
+    p = reinterpret_cast<const uint8_t *>(t.data);
+
+    DlTensorView    all(t);
+    DlTensorView    two = all.slice(1, 3);
+    DlTensorView    one = all.item(3);
+
+    TEST_CHECK((all.data == t.data) && (all.size == t.size));
+
+    TEST_CHECK(two.data == p + t.size / 4);
+    TEST_CHECK((two.shape == vector<int64_t>{2, 3, 8, 8}));
+    TEST_CHECK((two.size == t.size / 2) && (two.numElem == t.numElem / 2));
+
+    TEST_CHECK(one.data == p + 3 * (t.size / 4));
+    TEST_CHECK(one.shape[0] == 1);
+
+    try
+    {
+        all.slice(2, 5);
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+
+    TEST_CHECK(thrown);
+
+    /* A strided tensor steps by the stride of the leading dimension. */
+    t.shape   = {2, 3, 8, 8};
+    t.strides = {2*3*8*8, 8*8, 8, 1};
+    t.numElem = 2*3*8*8;
+    t.size    = t.numElem * t.elemSize;
+
+    TEST_CHECK(DlTensorView(t).item(1).data == p + t.size);
+    TEST_CHECK(numInUse() == base + 1);
+
+    return 0;
+}
+
+/* The deleter fires once, when the last tensor holding the memory lets go
+ * of it.
+ */
+static int32_t testWrapDeleter()
+{
+    NullInferer     inferer(makeSpec());
+    DlTensor        t = inferer.getInputInfo()->at(0).cloneInfo();
+    vector<uint8_t> mem0(t.size);
+    vector<uint8_t> mem1(t.size);
+    int32_t         numDeleted = 0;
+    auto            deleter = [&numDeleted](void *){ numDeleted++; };
+
+    TEST_CHECK(t.wrap(mem0.data(), mem0.size(), deleter) == 0);
+    TEST_CHECK(t.data == mem0.data());
+
+    {
+        DlTensor    s = t.share();
+
+        /* Wrapping again leaves the shared memory to 's'. */
+        TEST_CHECK(t.wrap(mem1.data(), mem1.size(), deleter) == 0);
+        TEST_CHECK(numDeleted == 0);
+        TEST_CHECK(s.data == mem0.data());
+    }
+
+    TEST_CHECK(numDeleted == 1);
+
+    /* A shape that still fits keeps the memory, a larger one replaces it. */
+    t.reshape({1, 3, 8, 8}, inferer);
+    TEST_CHECK((t.data == mem1.data()) && (numDeleted == 1));
+
+    t.reshape({8, 3, 8, 8}, inferer);
+    TEST_CHECK((t.data != mem1.data()) && (numDeleted == 2));
+
+    t = inferer.getInputInfo()->at(0).cloneInfo();
+    TEST_CHECK(t.wrap(mem0.data(), mem0.size(), deleter) == 0);
+    t = inferer.getInputInfo()->at(0).cloneInfo();
+    TEST_CHECK(numDeleted == 3);
+
+    {
+        DlTensor    u = inferer.getInputInfo()->at(0).cloneInfo();
+
+        TEST_CHECK(u.wrap(mem0.data(), mem0.size(), deleter) == 0);
+    }
+
+    TEST_CHECK(numDeleted == 4);
+
+    return 0;
+}
+
+/* The memory must span the whole tensor, strides included. */
+static int32_t testWrapSize()
+{
+    NullInferer     inferer(makeSpec());
+    DlTensor        t = inferer.getInputInfo()->at(0).cloneInfo();
+    int64_t         rowPitch = 16;
+    int64_t         extent;
+    vector<uint8_t> mem(4 * 3 * 8 * rowPitch * t.elemSize);
+    int32_t         numDeleted = 0;
+    auto            deleter = [&numDeleted](void *){ numDeleted++; };
+
+    /* Rejected memory is left to the caller. */
+    TEST_CHECK(t.wrap(mem.data(), t.size - 1, deleter) < 0);
+    TEST_CHECK(t.wrap(nullptr, t.size, deleter) < 0);
+    TEST_CHECK((t.data == nullptr) && (numDeleted == 0));
+
+    /* Rows of 8 elements, 16 apart. The last element lies past 'size'. */
+    t.strides = {3 * 8 * rowPitch, 8 * rowPitch, rowPitch, 1};
+    extent    = ((4 - 1) * t.strides[0] + (3 - 1) * t.strides[1] +
+                 (8 - 1) * t.strides[2] + 8) * t.elemSize;
+
+    TEST_CHECK(extent > t.size);
+    TEST_CHECK(t.wrap(mem.data(), t.size, deleter) < 0);
+    TEST_CHECK(t.wrap(mem.data(), extent - 1, deleter) < 0);
+    TEST_CHECK(t.wrap(mem.data(), extent, deleter) == 0);
+    TEST_CHECK(t.data == mem.data());
+
+    t = inferer.getInputInfo()->at(0).cloneInfo();
+    TEST_CHECK(numDeleted == 1);
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status = 0;
+
+    status |= testShare();
+    status |= testViews();
+    status |= testWrapDeleter();
+    status |= testWrapSize();
+
+    return reportStatus(status);
+}
@@ -0,0 +1,232 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer_trace.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* A span read back from a dumped trace. */
+struct TestSpan
+{
+    string  name;
+    double  ts;
+    double  dur;
+    int32_t tid;
+};
+
+static string getTracePath()
+{
+    return "/tmp/test_dl_inferer_trace_" + to_string(getpid()) + ".json";
+}
+
+/* Dumps the trace and parses the spans back. */
+static int32_t readTrace(vector<TestSpan> &spans)
+{
+    string      path = getTracePath();
+    ifstream    ifs;
+    string      line;
+
+    spans.clear();
+
+    TEST_CHECK(DlTracer::getInstance().dump(path) == 0);
+
+    ifs.open(path);
+    TEST_CHECK(ifs.is_open());
+
+    while (getline(ifs, line))
+    {
+        TestSpan    span;
+        char        name[32];
+        int32_t     pid;
+
+        if (sscanf(line.c_str(),
+                   "{\"name\":\"%31[^\"]\",\"cat\":\"dl_inferer\",\"ph\":\"X\","
+                   "\"ts\":%lf,\"dur\":%lf,\"pid\":%d,\"tid\":%d}",
+                   name, &span.ts, &span.dur, &pid, &span.tid) == 5)
+        {
+            span.name = name;
+            spans.push_back(span);
+        }
+    }
+
+    unlink(path.c_str());
+
+    return 0;
+}
+
+/* Threads started one after the other reuse a single ring, which keeps the
+ * spans of the last exited thread.
+ */
+static int32_t testRingReuse()
+{
+    vector<TestSpan>    spans;
+    set<int32_t>        tids;
+
+    for (int32_t t = 0; t < 32; t++)
+    {
+        thread  worker([t]{
+            for (uint64_t i = 0; i < 10; i++)
+            {
+                DlTracer::getInstance().record("reuse", t * 1000000 + i * 1000,
+                                               t * 1000000 + i * 1000 + 500);
+            }
+        });
+
+        worker.join();
+    }
+
+    TEST_CHECK(readTrace(spans) == 0);
+    TEST_CHECK(spans.size() == 10);
+
+    for (const auto &span : spans)
+    {
+        TEST_CHECK(span.name == "reuse");
+        TEST_CHECK(span.ts >= 31000.0);
+        tids.insert(span.tid);
+    }
+
+    TEST_CHECK(tids.size() == 1);
+
+    DlTracer::getInstance().clear();
+
+    return 0;
+}
+
+/* Dumping while a thread wraps its ring around only reports whole spans.
+ * The duration of a span tells which name it was recorded with.
+ */
+static int32_t testConcurrentDump()
+{
+    vector<TestSpan>    spans;
+    atomic<bool>        stop{false};
+    atomic<uint64_t>    numRecorded{0};
+    uint64_t            numSpans = 0;
+
+    thread  writer([&stop, &numRecorded]{
+        for (uint64_t i = 0; !stop; i++)
+        {
+            bool    even = (i % 2) == 0;
+
+            DlTracer::getInstance().record(even ? "even" : "odd", i * 10000,
+                                           i * 10000 + (even ? 2000 : 1000));
+            numRecorded = i + 1;
+        }
+    });
+
+    /* Let the writer wrap its ring around once. */
+    while (numRecorded < DlTracer::RING_SIZE)
+    {
+        this_thread::yield();
+    }
+
+    for (int32_t k = 0; k < 20; k++)
+    {
+        TEST_CHECK(readTrace(spans) == 0);
+
+        for (const auto &span : spans)
+        {
+            TEST_CHECK(span.dur == ((span.name == "even") ? 2.0 : 1.0));
+        }
+
+        numSpans += spans.size();
+    }
+
+    stop = true;
+    writer.join();
+
+    TEST_CHECK(numSpans > 0);
+
+    DlTracer::getInstance().clear();
+
+    return 0;
+}
+
+int main()
+{
+    int32_t status;
+
+    DlTracer::getInstance().enable(true);
+
+    status = testRingReuse();
+
+    if (status == 0)
+    {
+        status = testConcurrentDump();
+    }
+
+    DlTracer::getInstance().enable(false);
+
+    return reportStatus(status);
+}
@@ -0,0 +1,183 @@
+/*
+ *
+ * Copyright (c) 2022 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free, non-exclusive
+ * license under copyrights and patents it now or hereafter owns or controls to make,
+ * have made, use, import, offer to sell and sell ("Utilize") this software subject to the
+ * terms herein.  With respect to the foregoing patent license, such license is granted
+ * solely to the extent that any such patent is necessary to Utilize the software alone.
+ * The patent license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI ("TI Devices").
+ * No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce this license
+ * (including the above copyright notice and the disclaimer and (if applicable) source
+ * code license limitations below) in the documentation and/or other materials provided
+ * with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ * *       No reverse engineering, decompilation, or disassembly of this software is
+ * permitted with respect to any software provided in binary form.
+ *
+ * *       any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * *       Nothing shall obligate TI to provide you with source code for the software
+ * licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution of the
+ * source code are permitted provided that the following conditions are met:
+ *
+ * *       any redistribution and use of the source code, including any resulting derivative
+ * works, are licensed by TI for use only with TI Devices.
+ *
+ * *       any redistribution and use of any object code compiled from the source code
+ * and any resulting derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its suppliers
+ *
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/* Standard headers. */
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <ti_dl_inferer.h>
+#include <test_dl_inferer_common.h>
+
+using namespace std;
+using namespace ti::dl_inferer;
+using namespace ti::dl_inferer::test;
+
+/* Writes a synthetic model taking a single input of the given shape. */
+static string makeModel(const string &dir, const string &shape)
+{
+    ofstream    f(dir + "/param.yaml");
+
+    f << "task_type: classification\n"
+      << "session:\n"
+      << "  session_name: \"null\"\n"
+      << "  warmup_count: 3\n"
+      << "  warmup_pattern: random\n"
+      << "null_inferer:\n"
+      << "  latency_ms: 0\n"
+      << "  inputs:\n"
+      << "    - name: input\n"
+      << "      type: float32\n"
+      << "      shape: " << shape << "\n";
+
+    return dir;
+}
+
+static DLInferer *makeInferer(const string &dir)
+{
+    InfererConfig   config;
+
+    if (config.getConfig(dir, false) < 0)
+    {
+        return nullptr;
+    }
+
+    return DLInferer::makeInferer(config);
+}
+
+/* A dynamic batch dimension is warmed up with a single frame. */
+static int32_t testDynamicBatch(const string &dir)
+{
+    DLInferer      *inferer = makeInferer(makeModel(dir, "[-1, 3, 32, 32]"));
+    vector<float>   latencies;
+
+    TEST_CHECK(inferer != nullptr);
+    TEST_CHECK(inferer->isReady());
+    TEST_CHECK(inferer->getInputInfo()->at(0).size <= 0);
+
+    TEST_CHECK(inferer->warmup(2, "zero", 0.0f, &latencies) == 0);
+    TEST_CHECK(!latencies.empty());
+
+    delete inferer;
+    return 0;
+}
+
+/* Other dynamic dimensions skip the warm-up, the inferer stays usable. */
+static int32_t testDynamicSpatial(const string &dir)
+{
+    DLInferer      *inferer = makeInferer(makeModel(dir, "[1, 3, -1, -1]"));
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    vector<float>   latencies;
+
+    TEST_CHECK(inferer != nullptr);
+    TEST_CHECK(inferer->isReady());
+
+    TEST_CHECK(inferer->warmup(2, "random", 0.0f, &latencies) == 0);
+    TEST_CHECK(latencies.empty());
+
+    inferer->createBuffers(inferer->getInputInfo(), inputs, true);
+    inferer->createBuffers(inferer->getOutputInfo(), outputs, true);
+    TEST_CHECK(inputs[0]->data == nullptr);
+
+    inputs[0]->reshape({1, 3, 16, 24}, *inferer);
+    TEST_CHECK(inputs[0]->data != nullptr);
+    TEST_CHECK(inferer->run(inputs, outputs) == 0);
+
+    for (auto *t : inputs)
+    {
+        delete t;
+    }
+
+    for (auto *t : outputs)
+    {
+        delete t;
+    }
+
+    delete inferer;
+    return 0;
+}
+
+int main()
+{
+    char        tmpl[] = "/tmp/dl_inferer_warmup_XXXXXX";
+    const char *dir = mkdtemp(tmpl);
+    int32_t     status = 0;
+
+    if (dir == nullptr)
+    {
+        printf("[%s:%d] mkdtemp() failed.\n", __FUNCTION__, __LINE__);
+        return -1;
+    }
+
+    if ((testDynamicBatch(dir) < 0) || (testDynamicSpatial(dir) < 0))
+    {
+        status = -1;
+    }
+
+    unlink((string(dir) + "/param.yaml").c_str());
+    rmdir(dir);
+
+    return reportStatus(status);
+}